@@ -0,0 +1,69 @@
+#include "../string/string.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+String randomWord(std::mt19937& rng, size_t len) {
+    String res;
+    for (size_t i = 0; i < len; ++i) {
+        res.push_back(static_cast<char>('a' + rng() % 26));
+    }
+    return res;
+}
+
+template <class Func>
+double seconds(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t keywords = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    size_t megabytes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+    std::mt19937 rng(1);
+    std::vector<String> patterns;
+    for (size_t i = 0; i < keywords; ++i) {
+        patterns.push_back(randomWord(rng, 4 + rng() % 9));
+    }
+    String text;
+    text.reserve(megabytes << 20);
+    while (text.size() < megabytes << 20) {
+        text += randomWord(rng, 1 + rng() % 10);
+        text.push_back(' ');
+    }
+
+    double build = seconds([&] { AhoCorasick probe(patterns); });
+    AhoCorasick automaton(patterns);
+    size_t automaton_matches = 0;
+    double scan = seconds([&] {
+        automaton.scan(text, [&](size_t, size_t) { ++automaton_matches; });
+    });
+    size_t find_matches = 0;
+    double find = seconds([&] {
+        for (const String& pattern : patterns) {
+            StringView rest = text;
+            for (size_t pos = rest.find(pattern); pos != rest.size();
+                 pos = rest.find(pattern)) {
+                ++find_matches;
+                rest = rest.substr(pos + 1, rest.size() - pos - 1);
+            }
+        }
+    });
+
+    double gigabytes = static_cast<double>(text.size()) / 1e9;
+    std::printf("%zu keywords, %.1f MB text, %zu matches\n", keywords,
+                gigabytes * 1e3, automaton_matches);
+    std::printf("Aho-Corasick:   %.3f GB/s (build %.1f ms)\n",
+                gigabytes / scan, build * 1e3);
+    std::printf("repeated find:  %.3f GB/s\n", gigabytes / find);
+    return automaton_matches == find_matches ? 0 : 1;
+}
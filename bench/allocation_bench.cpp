@@ -0,0 +1,75 @@
+#include "../biginteger/biginteger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory_resource>
+#include <random>
+
+namespace {
+
+Rational work(unsigned seed, int steps) {
+    std::mt19937 rng(seed);
+    Rational res(1);
+    for (int step = 0; step < steps; ++step) {
+        int num = static_cast<int>(rng() % 2001) - 1000;
+        int den = static_cast<int>(rng() % 60) + 1;
+        Rational term = Rational(num) / Rational(den);
+        switch (rng() % 4) {
+            case 0:
+                res += term;
+                break;
+            case 1:
+                res -= term;
+                break;
+            case 2:
+                res *= term;
+                break;
+            default:
+                if (num != 0) {
+                    res /= term;
+                }
+        }
+        if (res.getDenominator().limbCount() > 40) {
+            res = Rational(3);
+        }
+    }
+    return res;
+}
+
+template <class Func>
+double seconds(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}  // namespace
+
+int main() {
+    const unsigned kBatches = 20;
+    const int kSteps = 20000;
+    for (int rep = 0; rep < 3; ++rep) {
+        double heap = seconds([&] {
+            for (unsigned seed = 0; seed < kBatches; ++seed) {
+                work(seed, kSteps);
+            }
+        });
+        double pool = seconds([&] {
+            for (unsigned seed = 0; seed < kBatches; ++seed) {
+                BigIntegerArena arena;
+                work(seed, kSteps);
+            }
+        });
+        double monotonic = seconds([&] {
+            for (unsigned seed = 0; seed < kBatches; ++seed) {
+                std::pmr::monotonic_buffer_resource buffer;
+                BigIntegerMemoryScope scope(&buffer);
+                work(seed, kSteps);
+            }
+        });
+        std::printf("heap %.3fs  arena %.3fs  monotonic %.3fs\n", heap, pool,
+                    monotonic);
+    }
+}
@@ -0,0 +1,51 @@
+#include "../biginteger/biginteger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace {
+
+template <class Func>
+double secondsPerCall(Func func) {
+    for (size_t reps = 1;; reps *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < reps; ++i) {
+            func();
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > 0.2) {
+            return elapsed.count() / reps;
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937_64 rng(1);
+    size_t sink = 0;
+    std::printf("%10s %14s %14s %16s\n", "digits", "toString ms", "parse ms",
+                "toString ns/d^2");
+    for (size_t digits : {1000, 3000, 10000, 30000, 100000, 300000, 1000000}) {
+        std::string str(digits, '0');
+        str[0] = static_cast<char>('1' + rng() % 9);
+        for (size_t i = 1; i < digits; ++i) {
+            str[i] = static_cast<char>('0' + rng() % 10);
+        }
+        BigInteger num(str);
+        if (num.toString() != str) {
+            std::printf("round trip failed at %zu digits\n", digits);
+            return 1;
+        }
+        double print = secondsPerCall([&] { sink += num.toString().size(); });
+        double parse =
+            secondsPerCall([&] { sink += BigInteger(str).limbCount(); });
+        double size = static_cast<double>(digits);
+        std::printf("%10zu %14.3f %14.3f %16.5f\n", digits, print * 1e3,
+                    parse * 1e3, print * 1e9 / (size * size));
+    }
+    return sink == 0;
+}
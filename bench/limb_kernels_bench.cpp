@@ -0,0 +1,32 @@
+#include "../biginteger/biginteger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+int main(int argc, char** argv) {
+    size_t limbs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    size_t iterations = 200000000 / limbs;
+    std::mt19937_64 rng(1);
+    BigInteger num1, num2;
+    for (size_t i = 0; i < limbs; ++i) {
+        num1 <<= 32;
+        num1 += static_cast<uint32_t>(rng());
+        num2 <<= 32;
+        num2 += static_cast<uint32_t>(rng());
+    }
+    BigInteger acc = num1;
+    size_t flags = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        acc += num1;
+        acc -= num2;
+        flags += acc < num1;
+        flags += acc == num2;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%zu limbs: %.1f ns per add+sub+2 compares (%zu)\n", limbs,
+                elapsed.count() * 1e9 / iterations, flags);
+}
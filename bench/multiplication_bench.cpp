@@ -0,0 +1,54 @@
+#include "../biginteger/biginteger.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace {
+
+BigInteger randomNumber(std::mt19937_64& rng, size_t limbs) {
+    std::string digits(limbs * 32 * 30103 / 100000 + 1, '0');
+    digits[0] = static_cast<char>('1' + rng() % 9);
+    for (size_t i = 1; i < digits.size(); ++i) {
+        digits[i] = static_cast<char>('0' + rng() % 10);
+    }
+    return BigInteger(digits);
+}
+
+template <class Func>
+double secondsPerCall(Func func) {
+    for (size_t reps = 1;; reps *= 2) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < reps; ++i) {
+            func();
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > 0.2) {
+            return elapsed.count() / reps;
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937_64 rng(1);
+    size_t sink = 0;
+    std::printf("%8s %14s %12s %14s\n", "limbs", "us/mul", "ns/n^2",
+                "ns/n^1.585");
+    for (size_t limbs : {8, 16, 24, 32, 40, 48, 64, 96, 128, 256, 512, 1024,
+                         1500, 2048, 2500, 3000, 4096, 8192, 16384}) {
+        BigInteger num1 = randomNumber(rng, limbs);
+        BigInteger num2 = randomNumber(rng, limbs);
+        double seconds =
+            secondsPerCall([&] { sink += (num1 * num2).limbCount(); });
+        double size = static_cast<double>(limbs);
+        std::printf("%8zu %14.3f %12.4f %14.4f\n", limbs, seconds * 1e6,
+                    seconds * 1e9 / (size * size),
+                    seconds * 1e9 / std::pow(size, 1.585));
+    }
+    return sink == 0;
+}
@@ -0,0 +1,59 @@
+#include "../biginteger/biginteger.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+BigInteger randomNumber(std::mt19937_64& rng, size_t digits) {
+    std::string str(digits, '0');
+    str[0] = static_cast<char>('1' + rng() % 9);
+    for (size_t i = 1; i < digits; ++i) {
+        str[i] = static_cast<char>('0' + rng() % 10);
+    }
+    return BigInteger(str);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t digits = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::mt19937_64 rng(1);
+    BigInteger num1 = randomNumber(rng, digits);
+    BigInteger num2 = randomNumber(rng, digits);
+    BigInteger expected = num1 * num2;
+    double base = 0;
+    std::printf("%zu-digit operands\n%8s %12s %10s\n", digits, "threads",
+                "ms", "speedup");
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+    for (size_t threads : counts) {
+        double best = 0;
+        for (int rep = 0; rep < 3; ++rep) {
+            auto start = std::chrono::steady_clock::now();
+            BigInteger product = multiply(num1, num2, threads);
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            if (product != expected) {
+                std::printf("mismatch at %zu threads\n", threads);
+                return 1;
+            }
+            if (rep == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        if (threads == 1) {
+            base = best;
+        }
+        std::printf("%8zu %12.1f %10.2f\n", threads, best * 1e3, base / best);
+    }
+}
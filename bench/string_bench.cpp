@@ -0,0 +1,64 @@
+#include "../string/string.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <class Func>
+double nanosPerOp(size_t ops, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() * 1e9 / ops;
+}
+
+template <class Str>
+size_t row(const char* name, size_t len) {
+    const size_t kOps = 2000000;
+    std::string source(len, 'k');
+    std::vector<Str> keep(64);
+    size_t sink = 0;
+    double construct = nanosPerOp(kOps, [&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            keep[i % 64] = Str(source.c_str());
+        }
+    });
+    Str original(source.c_str());
+    double copy = nanosPerOp(kOps, [&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            keep[i % 64] = original;
+        }
+    });
+    double append = nanosPerOp(kOps, [&] {
+        for (size_t i = 0; i < kOps; ++i) {
+            Str str;
+            for (size_t j = 0; j < len; ++j) {
+                str += 'a';
+            }
+            sink += str.size();
+        }
+    });
+    for (const Str& str : keep) {
+        sink += str.size();
+    }
+    std::printf("%-12s %4zu %12.1f %12.1f %12.1f\n", name, len, construct,
+                copy, append);
+    return sink;
+}
+
+}  // namespace
+
+int main() {
+    std::printf("%-12s %4s %12s %12s %12s\n", "type", "len", "construct ns",
+                "copy ns", "append ns");
+    size_t sink = 0;
+    for (size_t len : {0, 4, 8, 16, 22, 23, 24, 32, 64, 256}) {
+        sink += row<String>("String", len);
+        sink += row<std::string>("std::string", len);
+    }
+    return sink == 1;
+}
@@ -1,53 +1,1560 @@
 #include "biginteger.h"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <deque>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(BIGINTEGER_NO_SIMD)
+#include <immintrin.h>
+#define BIGINTEGER_X86_KERNELS
+#endif
+
+#ifdef BIGINTEGER_X86_KERNELS
+namespace {
+
+const bool kHasAvx512 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") != 0;
+}();
+
+const bool kHasAvx2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+}();
+
+__attribute__((target("avx512f"))) size_t addAvx512(uint32_t* res,
+                                                    const uint32_t* bnum,
+                                                    size_t len,
+                                                    uint64_t& carry) {
+    const __m512i kOnes = _mm512_set1_epi64(-1);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m512i num1 = _mm512_loadu_si512(res + i);
+        __m512i num2 = _mm512_loadu_si512(bnum + i);
+        __m512i sum = _mm512_add_epi64(num1, num2);
+        unsigned gen = _mm512_cmplt_epu64_mask(sum, num1);
+        unsigned prop = _mm512_cmpeq_epi64_mask(sum, kOnes);
+        unsigned carries = 2 * gen + prop + static_cast<unsigned>(carry);
+        __mmask8 inc = static_cast<__mmask8>(carries ^ prop);
+        sum = _mm512_mask_sub_epi64(sum, inc, sum, kOnes);
+        _mm512_storeu_si512(res + i, sum);
+        carry = carries >> 8;
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) size_t subAvx512(uint32_t* res,
+                                                    const uint32_t* bnum1,
+                                                    const uint32_t* bnum2,
+                                                    size_t len,
+                                                    uint64_t& borrow) {
+    const __m512i kOnes = _mm512_set1_epi64(-1);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m512i num1 = _mm512_loadu_si512(bnum1 + i);
+        __m512i num2 = _mm512_loadu_si512(bnum2 + i);
+        __m512i diff = _mm512_sub_epi64(num1, num2);
+        unsigned gen = _mm512_cmplt_epu64_mask(num1, num2);
+        unsigned prop = _mm512_cmpeq_epi64_mask(diff, _mm512_setzero_si512());
+        unsigned borrows = 2 * gen + prop + static_cast<unsigned>(borrow);
+        __mmask8 dec = static_cast<__mmask8>(borrows ^ prop);
+        diff = _mm512_mask_add_epi64(diff, dec, diff, kOnes);
+        _mm512_storeu_si512(res + i, diff);
+        borrow = borrows >> 8;
+    }
+    return i;
+}
+
+__attribute__((target("avx512f"))) size_t findDifferenceAvx512(
+    const uint32_t* bnum1, const uint32_t* bnum2, size_t len) {
+    for (; len >= 16; len -= 16) {
+        unsigned diff = _mm512_cmpneq_epi32_mask(
+            _mm512_loadu_si512(bnum1 + len - 16),
+            _mm512_loadu_si512(bnum2 + len - 16));
+        if (diff != 0) {
+            return len - 16 + std::bit_width(diff);
+        }
+    }
+    return len;
+}
+
+__attribute__((target("avx2"))) __m256i laneMaskAvx2(unsigned mask) {
+    const __m256i kBits = _mm256_setr_epi64x(1, 2, 4, 8);
+    return _mm256_cmpeq_epi64(
+        _mm256_and_si256(_mm256_set1_epi64x(mask), kBits), kBits);
+}
+
+__attribute__((target("avx2"))) unsigned lessMaskAvx2(__m256i num1,
+                                                      __m256i num2) {
+    const __m256i kSign = _mm256_set1_epi64x(INT64_MIN);
+    __m256i less = _mm256_cmpgt_epi64(_mm256_xor_si256(num2, kSign),
+                                      _mm256_xor_si256(num1, kSign));
+    return _mm256_movemask_pd(_mm256_castsi256_pd(less));
+}
+
+__attribute__((target("avx2"))) size_t addAvx2(uint32_t* res,
+                                               const uint32_t* bnum,
+                                               size_t len, uint64_t& carry) {
+    const __m256i kOnes = _mm256_set1_epi64x(-1);
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        __m256i num1 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(res + i));
+        __m256i num2 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bnum + i));
+        __m256i sum = _mm256_add_epi64(num1, num2);
+        unsigned gen = lessMaskAvx2(sum, num1);
+        unsigned prop = _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, kOnes)));
+        unsigned carries = 2 * gen + prop + static_cast<unsigned>(carry);
+        sum = _mm256_sub_epi64(sum, laneMaskAvx2((carries ^ prop) & 0xF));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), sum);
+        carry = carries >> 4;
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t subAvx2(uint32_t* res,
+                                               const uint32_t* bnum1,
+                                               const uint32_t* bnum2,
+                                               size_t len, uint64_t& borrow) {
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        __m256i num1 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bnum1 + i));
+        __m256i num2 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bnum2 + i));
+        __m256i diff = _mm256_sub_epi64(num1, num2);
+        unsigned gen = lessMaskAvx2(num1, num2);
+        unsigned prop = _mm256_movemask_pd(_mm256_castsi256_pd(
+            _mm256_cmpeq_epi64(diff, _mm256_setzero_si256())));
+        unsigned borrows = 2 * gen + prop + static_cast<unsigned>(borrow);
+        diff = _mm256_add_epi64(diff, laneMaskAvx2((borrows ^ prop) & 0xF));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(res + i), diff);
+        borrow = borrows >> 4;
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t findDifferenceAvx2(
+    const uint32_t* bnum1, const uint32_t* bnum2, size_t len) {
+    for (; len >= 8; len -= 8) {
+        __m256i same = _mm256_cmpeq_epi32(
+            _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(bnum1 + len - 8)),
+            _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(bnum2 + len - 8)));
+        unsigned diff = ~_mm256_movemask_ps(_mm256_castsi256_ps(same)) & 0xFF;
+        if (diff != 0) {
+            return len - 8 + std::bit_width(diff);
+        }
+    }
+    return len;
+}
+
+size_t addVector(uint32_t* res, const uint32_t* bnum, size_t len,
+                 uint64_t& carry) {
+    if (kHasAvx512) {
+        return addAvx512(res, bnum, len, carry);
+    }
+    if (kHasAvx2) {
+        return addAvx2(res, bnum, len, carry);
+    }
+    return 0;
+}
+
+size_t subVector(uint32_t* res, const uint32_t* bnum1, const uint32_t* bnum2,
+                 size_t len, uint64_t& borrow) {
+    if (kHasAvx512) {
+        return subAvx512(res, bnum1, bnum2, len, borrow);
+    }
+    if (kHasAvx2) {
+        return subAvx2(res, bnum1, bnum2, len, borrow);
+    }
+    return 0;
+}
+
+size_t findDifferenceVector(const uint32_t* bnum1, const uint32_t* bnum2,
+                            size_t len) {
+    if (kHasAvx512) {
+        return findDifferenceAvx512(bnum1, bnum2, len);
+    }
+    if (kHasAvx2) {
+        return findDifferenceAvx2(bnum1, bnum2, len);
+    }
+    return len;
+}
+
+}  // namespace
+#endif
+
+thread_local std::pmr::memory_resource* BigInteger::threadResource = nullptr;
+
+std::pmr::memory_resource* BigInteger::heapOrResource(
+    std::pmr::memory_resource* resource) {
+    return resource == std::pmr::new_delete_resource() ? nullptr : resource;
+}
+
+BigInteger::LimbBuffer::LimbBuffer()
+    : sz(0), cap(kInlineCap), storage(), resource(threadResource) {}
+
+BigInteger::LimbBuffer::LimbBuffer(std::pmr::memory_resource* memory)
+    : sz(0), cap(kInlineCap), storage(), resource(heapOrResource(memory)) {}
+
+BigInteger::LimbBuffer::LimbBuffer(const LimbBuffer& buffer)
+    : sz(0), cap(kInlineCap), storage(), resource(threadResource) {
+    assign(buffer.begin(), buffer.end());
+}
+
+BigInteger::LimbBuffer::LimbBuffer(LimbBuffer&& buffer) noexcept
+    : sz(buffer.sz),
+      cap(buffer.cap),
+      storage(buffer.storage),
+      resource(buffer.resource) {
+    buffer.sz = 0;
+    buffer.cap = kInlineCap;
+}
+
+BigInteger::LimbBuffer& BigInteger::LimbBuffer::operator=(
+    const LimbBuffer& buffer) {
+    if (this != &buffer) {
+        assign(buffer.begin(), buffer.end());
+    }
+    return *this;
+}
+
+BigInteger::LimbBuffer& BigInteger::LimbBuffer::operator=(
+    LimbBuffer&& buffer) {
+    adopt(buffer);
+    return *this;
+}
+
+BigInteger::LimbBuffer::~LimbBuffer() {
+    release();
+}
+
+void BigInteger::LimbBuffer::release() {
+    if (cap == kInlineCap) {
+        return;
+    }
+    if (resource != nullptr) {
+        resource->deallocate(storage.heap, cap * sizeof(Limb), alignof(Limb));
+    } else {
+        delete[] storage.heap;
+    }
+}
+
+void BigInteger::LimbBuffer::swap(LimbBuffer& buffer) noexcept {
+    std::swap(sz, buffer.sz);
+    std::swap(cap, buffer.cap);
+    std::swap(storage, buffer.storage);
+    std::swap(resource, buffer.resource);
+}
+
+void BigInteger::LimbBuffer::adopt(LimbBuffer& buffer) {
+    if (resource == buffer.resource) {
+        swap(buffer);
+    } else {
+        assign(buffer.begin(), buffer.end());
+    }
+}
+
+void BigInteger::LimbBuffer::reserve(size_t new_cap) {
+    if (new_cap <= cap) {
+        return;
+    }
+    Limb* new_limbs =
+        resource != nullptr
+            ? static_cast<Limb*>(
+                  resource->allocate(new_cap * sizeof(Limb), alignof(Limb)))
+            : new Limb[new_cap];
+    std::copy(data(), data() + sz, new_limbs);
+    release();
+    storage.heap = new_limbs;
+    cap = new_cap;
+}
+
+void BigInteger::LimbBuffer::resize(size_t new_sz) {
+    if (new_sz > cap) {
+        reserve(std::max(new_sz, cap * 2));
+    }
+    if (new_sz > sz) {
+        std::fill(data() + sz, data() + new_sz, 0);
+    }
+    sz = new_sz;
+}
+
+void BigInteger::LimbBuffer::assign(const Limb* first, const Limb* last) {
+    sz = 0;
+    resize(last - first);
+    std::copy(first, last, data());
+}
+
+void BigInteger::LimbBuffer::insertZeros(size_t count) {
+    size_t old_sz = sz;
+    resize(sz + count);
+    std::memmove(data() + count, data(), old_sz * sizeof(Limb));
+    std::fill(data(), data() + count, 0);
+}
+
+BigInteger::ScratchArena::Frame::Frame()
+    : arena(local()), block(arena.block), used(arena.used) {}
+
+BigInteger::ScratchArena::Frame::~Frame() {
+    arena.block = block;
+    arena.used = used;
+}
+
+BigInteger::Limb* BigInteger::ScratchArena::Frame::allocate(size_t count) {
+    while (arena.block < arena.blocks.size() &&
+           arena.sizes[arena.block] - arena.used < count) {
+        ++arena.block;
+        arena.used = 0;
+    }
+    if (arena.block == arena.blocks.size()) {
+        size_t size = std::max(count, kMinBlock);
+        if (!arena.sizes.empty()) {
+            size = std::max(size, 2 * arena.sizes.back());
+        }
+        arena.blocks.emplace_back(new Limb[size]);
+        arena.sizes.push_back(size);
+    }
+    Limb* res = arena.blocks[arena.block].get() + arena.used;
+    arena.used += count;
+    return res;
+}
+
+BigInteger::ScratchArena& BigInteger::ScratchArena::local() {
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+void BigInteger::swap(BigInteger& bnum) {
+    std::swap(isNegative, bnum.isNegative);
+    std::swap(digits, bnum.digits);
+}
+
+void BigInteger::removeLeadingZeros() {
+    while (!digits.empty() && digits.back() == 0) {
+        digits.pop_back();
+    }
+}
+
+BigInteger BigInteger::limbSlice(size_t start, size_t count) const {
+    BigInteger res;
+    if (start < digits.size()) {
+        size_t end = std::min(digits.size(), start + count);
+        res.digits.assign(digits.data() + start, digits.data() + end);
+        res.removeLeadingZeros();
+    }
+    return res;
+}
+
+void BigInteger::shiftLimbs(size_t count) {
+    if (!digits.empty()) {
+        digits.insertZeros(count);
+    }
+}
+
+BigInteger::Limb BigInteger::divideByLimb(Limb divisor) {
+    int shift = std::countl_zero(divisor);
+    Limb norm = divisor << shift;
+    Limb recip = ~DoubleLimb(0) / norm - kNumSys;
+    Limb rem = 0;
+    for (size_t i = digits.size(); i-- > 0;) {
+        DoubleLimb now_num = static_cast<DoubleLimb>(digits[i]) << shift;
+        Limb high = rem | static_cast<Limb>(now_num >> 32);
+        Limb low = now_num;
+        DoubleLimb guess = static_cast<DoubleLimb>(recip) * high +
+                           (static_cast<DoubleLimb>(high) << 32 | low);
+        Limb quot = (guess >> 32) + 1;
+        rem = low - quot * norm;
+        if (rem > static_cast<Limb>(guess)) {
+            --quot;
+            rem += norm;
+        }
+        if (rem >= norm) {
+            ++quot;
+            rem -= norm;
+        }
+        digits[i] = quot;
+    }
+    removeLeadingZeros();
+    return rem >> shift;
+}
+
+void BigInteger::mulAddLimb(Limb mul, Limb add) {
+    DoubleLimb transf = add;
+    for (size_t i = 0; i < digits.size(); ++i) {
+        transf += static_cast<DoubleLimb>(digits[i]) * mul;
+        digits[i] = transf % kNumSys;
+        transf /= kNumSys;
+    }
+    if (transf != 0) {
+        digits.push_back(transf);
+    }
+}
+
+BigInteger::Limb BigInteger::addLimbs(Limb* res, size_t res_len,
+                                      const Limb* bnum, size_t bnum_len) {
+    DoubleLimb transf = 0;
+    size_t i = 0;
+#ifdef BIGINTEGER_X86_KERNELS
+    if (bnum_len >= kSimdThreshold) {
+        i = addVector(res, bnum, bnum_len, transf);
+    }
+#endif
+    for (; i < bnum_len; ++i) {
+        transf += static_cast<DoubleLimb>(res[i]) + bnum[i];
+        if (transf < kNumSys) {
+            res[i] = transf;
+            transf = 0;
+        } else {
+            res[i] = transf - kNumSys;
+            transf = 1;
+        }
+    }
+    for (; transf != 0 && i < res_len; ++i) {
+        if (res[i] + transf < kNumSys) {
+            res[i] += transf;
+            transf = 0;
+        } else {
+            res[i] = 0;
+        }
+    }
+    return transf;
+}
+
+void BigInteger::subLimbs(Limb* res, size_t res_len, const Limb* bnum,
+                          size_t bnum_len) {
+    DoubleLimb borrow = 0;
+    size_t i = 0;
+#ifdef BIGINTEGER_X86_KERNELS
+    if (bnum_len >= kSimdThreshold) {
+        i = subVector(res, res, bnum, bnum_len, borrow);
+    }
+#endif
+    for (; i < bnum_len; ++i) {
+        DoubleLimb sub = static_cast<DoubleLimb>(bnum[i]) + borrow;
+        if (res[i] >= sub) {
+            res[i] -= sub;
+            borrow = 0;
+        } else {
+            res[i] = res[i] + kNumSys - sub;
+            borrow = 1;
+        }
+    }
+    for (; borrow != 0 && i < res_len; ++i) {
+        if (res[i] != 0) {
+            --res[i];
+            borrow = 0;
+        } else {
+            res[i] = kNumSys - 1;
+        }
+    }
+}
+
+void BigInteger::subReversedLimbs(Limb* res, const Limb* bnum, size_t len) {
+    DoubleLimb borrow = 0;
+    size_t i = 0;
+#ifdef BIGINTEGER_X86_KERNELS
+    if (len >= kSimdThreshold) {
+        i = subVector(res, bnum, res, len, borrow);
+    }
+#endif
+    for (; i < len; ++i) {
+        DoubleLimb sub = static_cast<DoubleLimb>(res[i]) + borrow;
+        if (bnum[i] >= sub) {
+            res[i] = bnum[i] - sub;
+            borrow = 0;
+        } else {
+            res[i] = bnum[i] + kNumSys - sub;
+            borrow = 1;
+        }
+    }
+}
+
+void BigInteger::mulSchoolbook(const Limb* bnum1, size_t len1,
+                               const Limb* bnum2, size_t len2, Limb* res) {
+    std::fill(res, res + len1 + len2, 0);
+    for (size_t i = 0; i < len2; ++i) {
+        if (bnum2[i] == 0) {
+            continue;
+        }
+        DoubleLimb transf = 0;
+        for (size_t j = 0; j < len1; ++j) {
+            transf += res[i + j] + static_cast<DoubleLimb>(bnum1[j]) * bnum2[i];
+            res[i + j] = transf % kNumSys;
+            transf /= kNumSys;
+        }
+        res[i + len1] = transf;
+    }
+}
+
+void BigInteger::sqrSchoolbook(const Limb* bnum, size_t len, Limb* res) {
+    std::fill(res, res + 2 * len, 0);
+    for (size_t i = 0; i < len; ++i) {
+        if (bnum[i] == 0) {
+            continue;
+        }
+        DoubleLimb transf = 0;
+        for (size_t j = i + 1; j < len; ++j) {
+            transf += res[i + j] + static_cast<DoubleLimb>(bnum[i]) * bnum[j];
+            res[i + j] = transf % kNumSys;
+            transf /= kNumSys;
+        }
+        res[i + len] = transf;
+    }
+    Limb top = 0;
+    for (size_t i = 0; i < 2 * len; ++i) {
+        Limb next = res[i] >> 31;
+        res[i] = res[i] << 1 | top;
+        top = next;
+    }
+    DoubleLimb transf = 0;
+    for (size_t i = 0; i < len; ++i) {
+        DoubleLimb square = static_cast<DoubleLimb>(bnum[i]) * bnum[i];
+        transf += res[2 * i] + square % kNumSys;
+        res[2 * i] = transf % kNumSys;
+        transf /= kNumSys;
+        transf += res[2 * i + 1] + square / kNumSys;
+        res[2 * i + 1] = transf % kNumSys;
+        transf /= kNumSys;
+    }
+}
+
+void BigInteger::sqrKaratsuba(const Limb* bnum, size_t len, Limb* res,
+                              Limb* scratch) {
+    if (len < kKaratsubaThreshold) {
+        sqrSchoolbook(bnum, len, res);
+        return;
+    }
+    size_t low = len / 2, high = len - low;
+    sqrKaratsuba(bnum, low, res, scratch);
+    sqrKaratsuba(bnum + low, high, res + 2 * low, scratch);
+    Limb* sum = scratch;
+    Limb* middle = sum + high + 1;
+    std::copy(bnum + low, bnum + len, sum);
+    sum[high] = addLimbs(sum, high, bnum, low);
+    size_t middle_len = 2 * high + 2;
+    sqrKaratsuba(sum, high + 1, middle, middle + middle_len);
+    subLimbs(middle, middle_len, res, 2 * low);
+    subLimbs(middle, middle_len, res + 2 * low, 2 * high);
+    while (middle_len > 0 && middle[middle_len - 1] == 0) {
+        --middle_len;
+    }
+    addLimbs(res + low, 2 * len - low, middle, middle_len);
+}
+
+size_t BigInteger::mulScratchSize(size_t len1, size_t len2) {
+    if (len1 < len2) {
+        std::swap(len1, len2);
+    }
+    if (len2 < kKaratsubaThreshold) {
+        return 0;
+    }
+    if (len1 == len2) {
+        size_t high = len1 - len1 / 2;
+        return 4 * (high + 1) + mulScratchSize(high + 1, high + 1);
+    }
+    size_t res = mulScratchSize(len2, len2);
+    if (len1 % len2 != 0) {
+        res = std::max(res, mulScratchSize(len2, len1 % len2));
+    }
+    return 2 * len2 + res;
+}
+
+void BigInteger::mulKaratsuba(const Limb* bnum1, const Limb* bnum2,
+                              size_t len, Limb* res, Limb* scratch) {
+    if (len < kKaratsubaThreshold) {
+        mulSchoolbook(bnum1, len, bnum2, len, res);
+        return;
+    }
+    size_t low = len / 2, high = len - low;
+    mulKaratsuba(bnum1, bnum2, low, res, scratch);
+    mulKaratsuba(bnum1 + low, bnum2 + low, high, res + 2 * low, scratch);
+    Limb* sum1 = scratch;
+    Limb* sum2 = sum1 + high + 1;
+    Limb* middle = sum2 + high + 1;
+    std::copy(bnum1 + low, bnum1 + len, sum1);
+    std::copy(bnum2 + low, bnum2 + len, sum2);
+    sum1[high] = addLimbs(sum1, high, bnum1, low);
+    sum2[high] = addLimbs(sum2, high, bnum2, low);
+    size_t middle_len = 2 * high + 2;
+    mulKaratsuba(sum1, sum2, high + 1, middle, middle + middle_len);
+    subLimbs(middle, middle_len, res, 2 * low);
+    subLimbs(middle, middle_len, res + 2 * low, 2 * high);
+    while (middle_len > 0 && middle[middle_len - 1] == 0) {
+        --middle_len;
+    }
+    addLimbs(res + low, 2 * len - low, middle, middle_len);
+}
+
+void BigInteger::mulLimbs(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                          size_t len2, Limb* res, Limb* scratch) {
+    if (len1 < len2) {
+        std::swap(bnum1, bnum2);
+        std::swap(len1, len2);
+    }
+    if (bnum1 == bnum2 && len1 == len2) {
+        sqrKaratsuba(bnum1, len1, res, scratch);
+        return;
+    }
+    if (len2 < kKaratsubaThreshold) {
+        mulSchoolbook(bnum1, len1, bnum2, len2, res);
+        return;
+    }
+    if (len1 == len2) {
+        mulKaratsuba(bnum1, bnum2, len1, res, scratch);
+        return;
+    }
+    std::fill(res, res + len1 + len2, 0);
+    Limb* now_res = scratch;
+    for (size_t start = 0; start < len1; start += len2) {
+        size_t now_len = std::min(len2, len1 - start);
+        mulLimbs(bnum1 + start, now_len, bnum2, len2, now_res,
+                 scratch + 2 * len2);
+        addLimbs(res + start, len1 + len2 - start, now_res, now_len + len2);
+    }
+}
+
+uint32_t BigInteger::powModWord(DoubleLimb base, DoubleLimb exp,
+                                uint32_t mod) {
+    DoubleLimb res = 1;
+    base %= mod;
+    for (; exp > 0; exp >>= 1) {
+        if ((exp & 1) != 0) {
+            res = res * base % mod;
+        }
+        base = base * base % mod;
+    }
+    return res;
+}
+
+std::pair<size_t, size_t> BigInteger::Worker::range(size_t total) const {
+    size_t step = (total + count - 1) / count;
+    size_t from = std::min(rank * step, total);
+    return {from, std::min(from + step, total)};
+}
+
+void BigInteger::Worker::wait() const {
+    sync.arrive_and_wait();
+}
+
+template <class Func>
+void BigInteger::runWorkers(size_t threads, Func func) {
+    std::barrier<> sync(static_cast<std::ptrdiff_t>(threads));
+    std::vector<std::thread> workers;
+    for (size_t rank = 1; rank < threads; ++rank) {
+        workers.emplace_back([&, rank] { func(Worker{rank, threads, sync}); });
+    }
+    func(Worker{0, threads, sync});
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+template <uint32_t kMod>
+void BigInteger::transformNtt(std::vector<uint32_t>& poly,
+                              const std::vector<uint32_t>& roots,
+                              const Worker& worker) {
+    size_t size = poly.size();
+    auto [from, to] = worker.range(size);
+    size_t rev = 0;
+    for (size_t bit = 1, rev_bit = size >> 1; bit < size;
+         bit <<= 1, rev_bit >>= 1) {
+        if ((from & bit) != 0) {
+            rev |= rev_bit;
+        }
+    }
+    for (size_t i = from; i < to; ++i) {
+        if (i < rev) {
+            std::swap(poly[i], poly[rev]);
+        }
+        size_t bit = size >> 1;
+        for (; (rev & bit) != 0; bit >>= 1) {
+            rev ^= bit;
+        }
+        rev ^= bit;
+    }
+    worker.wait();
+    auto [pair_from, pair_to] = worker.range(size / 2);
+    for (size_t len = 2; len <= size; len <<= 1) {
+        size_t half = len / 2;
+        for (size_t k = pair_from; k < pair_to;) {
+            size_t j = k % half, i = 2 * (k - j);
+            for (; j < half && k < pair_to; ++j, ++k) {
+                uint32_t u = poly[i + j];
+                uint32_t v = static_cast<DoubleLimb>(poly[i + j + half]) *
+                             roots[half + j] % kMod;
+                poly[i + j] = u + v < kMod ? u + v : u + v - kMod;
+                poly[i + j + half] = u >= v ? u - v : u + kMod - v;
+            }
+        }
+        worker.wait();
+    }
+}
+
+template <uint32_t kMod, uint32_t kRoot>
+void BigInteger::convolveNtt(const std::vector<uint32_t>& pieces1,
+                             const std::vector<uint32_t>& pieces2,
+                             std::vector<uint32_t>& res,
+                             std::vector<uint32_t>& other,
+                             std::vector<uint32_t>& roots,
+                             const Worker& worker) {
+    size_t size = pieces1.size();
+    bool square = &pieces1 == &pieces2;
+    auto [from, to] = worker.range(size);
+    for (size_t i = from; i < to; ++i) {
+        res[i] = pieces1[i] % kMod;
+        if (!square) {
+            other[i] = pieces2[i] % kMod;
+        }
+    }
+    // Stage len reads its len / 2 roots from roots[len / 2, len), so every
+    // stage walks a contiguous run of the table.
+    DoubleLimb root = 0, power = 0;
+    for (size_t i = std::max<size_t>(from, 1); i < to; ++i) {
+        size_t half = std::bit_floor(i);
+        if (i == half || root == 0) {
+            root = powModWord(kRoot, (kMod - 1) / (2 * half), kMod);
+            power = powModWord(root, i - half, kMod);
+        }
+        roots[i] = power;
+        power = power * root % kMod;
+    }
+    worker.wait();
+    transformNtt<kMod>(res, roots, worker);
+    if (!square) {
+        transformNtt<kMod>(other, roots, worker);
+    }
+    const std::vector<uint32_t>& factor = square ? res : other;
+    for (size_t i = from; i < to; ++i) {
+        res[i] = static_cast<DoubleLimb>(res[i]) * factor[i] % kMod;
+    }
+    worker.wait();
+    // The inverse transform is the forward one read backwards: entry i of
+    // the result is entry (size - i) % size of the transform, over size.
+    transformNtt<kMod>(res, roots, worker);
+    DoubleLimb inv_size = powModWord(size, kMod - 2, kMod);
+    auto [pair_from, pair_to] = worker.range(size / 2 + 1);
+    for (size_t i = pair_from; i < pair_to; ++i) {
+        size_t j = (size - i) % size;
+        uint32_t low = res[i];
+        res[i] = res[j] * inv_size % kMod;
+        if (j != i) {
+            res[j] = low * inv_size % kMod;
+        }
+    }
+}
+
+void BigInteger::mulNtt(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                        size_t len2, Limb* res, size_t threads) {
+    size_t piece_bits = std::min(len1, len2) > kNttSplitThreshold ? 16 : 32;
+    size_t per_limb = 32 / piece_bits, size = 1;
+    while (size < per_limb * (len1 + len2)) {
+        size <<= 1;
+    }
+    const DoubleLimb mask = (DoubleLimb(1) << piece_bits) - 1;
+    bool square = bnum1 == bnum2 && len1 == len2;
+    std::vector<uint32_t> pieces1(size), pieces2(square ? 0 : size);
+    for (size_t i = 0; i < per_limb * len1; ++i) {
+        pieces1[i] = bnum1[i / per_limb] >> (i % per_limb * piece_bits) & mask;
+    }
+    for (size_t i = 0; !square && i < per_limb * len2; ++i) {
+        pieces2[i] = bnum2[i / per_limb] >> (i % per_limb * piece_bits) & mask;
+    }
+    const std::vector<uint32_t>& factor = square ? pieces1 : pieces2;
+    std::vector<uint32_t> rem1(size), rem2(size), rem3(size);
+    std::vector<uint32_t> other(square ? 0 : size), roots(size);
+    // The workers are started once and share all three convolutions, so a
+    // transform costs barrier waits rather than thread spawns per stage.
+    runWorkers(std::max<size_t>(threads, 1), [&](const Worker& worker) {
+        convolveNtt<kNttMod1, 3>(pieces1, factor, rem1, other, roots, worker);
+        convolveNtt<kNttMod2, 3>(pieces1, factor, rem2, other, roots, worker);
+        convolveNtt<kNttMod3, 11>(pieces1, factor, rem3, other, roots, worker);
+    });
+    const DoubleLimb inv1_mod2 = powModWord(kNttMod1, kNttMod2 - 2, kNttMod2);
+    const DoubleLimb mod12 = static_cast<DoubleLimb>(kNttMod1) * kNttMod2;
+    const DoubleLimb inv12_mod3 =
+        powModWord(mod12 % kNttMod3, kNttMod3 - 2, kNttMod3);
+    std::fill(res, res + len1 + len2, 0);
+    unsigned __int128 transf = 0;
+    for (size_t i = 0; i < per_limb * (len1 + len2); ++i) {
+        DoubleLimb coef12 =
+            (rem2[i] + kNttMod2 - rem1[i] % kNttMod2) * inv1_mod2 % kNttMod2;
+        coef12 = rem1[i] + coef12 * kNttMod1;
+        DoubleLimb coef3 =
+            (rem3[i] + kNttMod3 - coef12 % kNttMod3) * inv12_mod3 % kNttMod3;
+        transf += coef12 + static_cast<unsigned __int128>(coef3) * mod12;
+        res[i / per_limb] |= static_cast<Limb>(transf & mask)
+                             << (i % per_limb * piece_bits);
+        transf >>= piece_bits;
+    }
+}
+
+BigInteger BigInteger::mulToom3(const BigInteger& bnum1,
+                                const BigInteger& bnum2, size_t threads) {
+    const BigInteger& longer = bnum1.limbCount() < bnum2.limbCount() ? bnum2
+                                                                      : bnum1;
+    const BigInteger& shorter = bnum1.limbCount() < bnum2.limbCount() ? bnum1
+                                                                       : bnum2;
+    size_t len1 = longer.limbCount(), len2 = shorter.limbCount();
+    if (len1 > 2 * len2) {
+        BigInteger res;
+        for (size_t start = (len1 - 1) / len2 * len2;; start -= len2) {
+            BigInteger now_res =
+                multiply(longer.limbSlice(start, len2), shorter, threads);
+            now_res.isNegative = false;
+            res.shiftLimbs(len2);
+            res += now_res;
+            if (start == 0) {
+                break;
+            }
+        }
+        return res;
+    }
+    size_t part = (len1 + 2) / 3;
+    BigInteger a0 = longer.limbSlice(0, part), a1 = longer.limbSlice(part, part),
+               a2 = longer.limbSlice(2 * part, part);
+    BigInteger a_sum = a0 + a2;
+    BigInteger a_minus1 = a_sum - a1;
+    BigInteger a_minus2 = a_minus1 + a2;
+    a_minus2 += a_minus2;
+    a_minus2 -= a0;
+    a_sum += a1;
+    BigInteger b0, b2, b_sum, b_minus1, b_minus2;
+    bool square = &bnum1 == &bnum2;
+    if (!square) {
+        b0 = shorter.limbSlice(0, part);
+        b2 = shorter.limbSlice(2 * part, part);
+        BigInteger b1 = shorter.limbSlice(part, part);
+        b_sum = b0 + b2;
+        b_minus1 = b_sum - b1;
+        b_minus2 = b_minus1 + b2;
+        b_minus2 += b_minus2;
+        b_minus2 -= b0;
+        b_sum += b1;
+    }
+    size_t now_threads = std::max<size_t>(threads / 5, 1);
+    std::launch policy =
+        threads > 1 ? std::launch::async : std::launch::deferred;
+    auto product = [now_threads](const BigInteger* lhs, const BigInteger* rhs) {
+        return multiply(*lhs, *rhs, now_threads);
+    };
+    std::future<BigInteger> future0 = std::async(
+        policy, product, &a0, square ? &a0 : &b0);
+    std::future<BigInteger> future1 = std::async(
+        policy, product, &a_sum, square ? &a_sum : &b_sum);
+    std::future<BigInteger> future_minus1 = std::async(
+        policy, product, &a_minus1, square ? &a_minus1 : &b_minus1);
+    std::future<BigInteger> future_minus2 = std::async(
+        policy, product, &a_minus2, square ? &a_minus2 : &b_minus2);
+    BigInteger r_inf = product(&a2, square ? &a2 : &b2);
+    BigInteger r0 = future0.get(), r1 = future1.get(),
+               r_minus1 = future_minus1.get(), r_minus2 = future_minus2.get();
+    BigInteger r3 = r_minus2 - r1;
+    r3.divideByLimb(3);
+    r1 -= r_minus1;
+    r1.divideByLimb(2);
+    BigInteger r2 = r_minus1 - r0;
+    r3 = r2 - r3;
+    r3.divideByLimb(2);
+    r3 += r_inf;
+    r3 += r_inf;
+    r2 += r1;
+    r2 -= r_inf;
+    r1 -= r3;
+    BigInteger res = r_inf;
+    for (BigInteger* coef : {&r3, &r2, &r1, &r0}) {
+        res.shiftLimbs(part);
+        res += *coef;
+    }
+    res.isNegative = false;
+    return res;
+}
+
+void BigInteger::mulMagnitudes(const BigInteger& bnum1,
+                               const BigInteger& bnum2, LimbBuffer& res,
+                               size_t threads) {
+    size_t len1 = bnum1.digits.size(), len2 = bnum2.digits.size();
+    size_t min_len = std::min(len1, len2);
+    if (min_len < kParallelThreshold) {
+        threads = 1;
+    }
+    size_t ntt_len = (min_len > kNttSplitThreshold ? 2 : 1) * (len1 + len2);
+    if (min_len >= kToomThreshold &&
+        (min_len < kNttThreshold || ntt_len > kMaxNttLength)) {
+        BigInteger product = mulToom3(bnum1, bnum2, threads);
+        res.adopt(product.digits);
+        return;
+    }
+    res.clear();
+    res.resize(len1 + len2);
+    if (min_len >= kNttThreshold) {
+        mulNtt(bnum1.digits.data(), len1, bnum2.digits.data(), len2,
+               res.data(), threads);
+    } else {
+        ScratchArena::Frame frame;
+        mulLimbs(bnum1.digits.data(), len1, bnum2.digits.data(), len2,
+                 res.data(), frame.allocate(mulScratchSize(len1, len2)));
+    }
+    while (!res.empty() && res.back() == 0) {
+        res.pop_back();
+    }
+}
+
+int BigInteger::compareLimbs(const Limb* bnum1, size_t len1,
+                             const Limb* bnum2, size_t len2) {
+    if (len1 != len2) {
+        return len1 < len2 ? -1 : 1;
+    }
+    size_t top = len1;
+#ifdef BIGINTEGER_X86_KERNELS
+    if (len1 >= kSimdThreshold) {
+        top = findDifferenceVector(bnum1, bnum2, len1);
+    }
+#endif
+    for (size_t i = top; i-- > 0;) {
+        if (bnum1[i] != bnum2[i]) {
+            return bnum1[i] < bnum2[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+void BigInteger::addSigned(const Limb* bnum, size_t len, bool negative) {
+    if (isNegative == negative) {
+        if (digits.size() < len) {
+            digits.resize(len);
+        }
+        Limb transf = addLimbs(digits.data(), digits.size(), bnum, len);
+        if (transf != 0) {
+            digits.push_back(transf);
+        }
+        return;
+    }
+    if (compareLimbs(digits.data(), digits.size(), bnum, len) >= 0) {
+        subLimbs(digits.data(), digits.size(), bnum, len);
+    } else {
+        digits.resize(len);
+        subReversedLimbs(digits.data(), bnum, len);
+        isNegative = !isNegative;
+    }
+    removeLeadingZeros();
+}
+
+void BigInteger::divKnuth(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                          size_t len2, Limb* quotient, Limb* remainder) {
+    ScratchArena::Frame frame;
+    Limb* num = frame.allocate(len1 + 1);
+    Limb* div = frame.allocate(len2);
+    Limb norm = kNumSys / (static_cast<DoubleLimb>(bnum2[len2 - 1]) + 1);
+    DoubleLimb transf = 0;
+    for (size_t i = 0; i < len1; ++i) {
+        transf += static_cast<DoubleLimb>(bnum1[i]) * norm;
+        num[i] = transf % kNumSys;
+        transf /= kNumSys;
+    }
+    num[len1] = transf;
+    transf = 0;
+    for (size_t i = 0; i < len2; ++i) {
+        transf += static_cast<DoubleLimb>(bnum2[i]) * norm;
+        div[i] = transf % kNumSys;
+        transf /= kNumSys;
+    }
+    DoubleLimb div_top = div[len2 - 1], div_next = div[len2 - 2];
+    for (size_t j = len1 - len2 + 1; j-- > 0;) {
+        DoubleLimb now_num = num[j + len2] * static_cast<DoubleLimb>(kNumSys) +
+                             num[j + len2 - 1];
+        DoubleLimb guess = now_num / div_top, rest = now_num % div_top;
+        while (guess >= kNumSys ||
+               guess * div_next > rest * kNumSys + num[j + len2 - 2]) {
+            --guess;
+            rest += div_top;
+            if (rest >= kNumSys) {
+                break;
+            }
+        }
+        DoubleLimb mul_transf = 0;
+        long long borrow = 0;
+        for (size_t i = 0; i < len2; ++i) {
+            mul_transf += guess * div[i];
+            long long now =
+                static_cast<long long>(num[i + j]) - borrow -
+                static_cast<long long>(mul_transf % kNumSys);
+            mul_transf /= kNumSys;
+            borrow = now < 0 ? 1 : 0;
+            num[i + j] = now + borrow * kNumSys;
+        }
+        long long top = static_cast<long long>(num[j + len2]) - borrow -
+                        static_cast<long long>(mul_transf);
+        if (top < 0) {
+            --guess;
+            top += addLimbs(num + j, len2, div, len2);
+        }
+        num[j + len2] = top;
+        quotient[j] = guess;
+    }
+    DoubleLimb rem = 0;
+    for (size_t i = len2; i-- > 0;) {
+        rem = rem * kNumSys + num[i];
+        remainder[i] = rem / norm;
+        rem %= norm;
+    }
+}
+
+BigInteger BigInteger::reciprocal(const BigInteger& bnum) {
+    size_t len = bnum.limbCount();
+    BigInteger power(1);
+    power.shiftLimbs(2 * len);
+    if (len < kNewtonThreshold) {
+        BigInteger res, rem;
+        divModAbs(power, bnum, res, rem);
+        return res;
+    }
+    size_t high = len / 2 + 2;
+    BigInteger res = reciprocal(bnum.limbSlice(len - high, high));
+    res.shiftLimbs(len - high);
+    BigInteger error = power - bnum * res;
+    BigInteger correction = (res * error).limbSlice(2 * len, 2 * len + 2);
+    if (error.isNegative) {
+        res -= correction;
+    } else {
+        res += correction;
+    }
+    BigInteger rem = power - bnum * res;
+    while (rem.isNegative && rem) {
+        --res;
+        rem += bnum;
+    }
+    rem.isNegative = false;
+    while (rem >= bnum) {
+        ++res;
+        rem -= bnum;
+    }
+    return res;
+}
+
+void BigInteger::divModNewton(const BigInteger& bnum1,
+                              const BigInteger& bnum2, const BigInteger& recip,
+                              BigInteger& quotient, BigInteger& remainder) {
+    size_t len = bnum2.limbCount();
+    size_t chunks = (bnum1.limbCount() + len - 1) / len;
+    quotient.digits.clear();
+    quotient.digits.resize(chunks * len);
+    remainder.clear();
+    for (size_t i = chunks; i-- > 0;) {
+        remainder.shiftLimbs(len);
+        remainder += bnum1.limbSlice(i * len, len);
+        BigInteger now_res = (remainder * recip).limbSlice(2 * len, len + 1);
+        remainder -= now_res * bnum2;
+        while (remainder >= bnum2) {
+            ++now_res;
+            remainder -= bnum2;
+        }
+        std::copy(now_res.digits.begin(), now_res.digits.end(),
+                  quotient.digits.data() + i * len);
+    }
+    quotient.removeLeadingZeros();
+    quotient.isNegative = false;
+}
+
+void BigInteger::divModAbs(const BigInteger& bnum1, const BigInteger& bnum2,
+                           BigInteger& quotient, BigInteger& remainder) {
+    const LimbBuffer &limbs1 = bnum1.digits, &limbs2 = bnum2.digits;
+    if (limbs2.empty()) {
+        throw std::domain_error("");
+    }
+    if (compareLimbs(limbs1.data(), limbs1.size(), limbs2.data(),
+                     limbs2.size()) < 0) {
+        quotient.clear();
+        remainder = bnum1;
+        remainder.isNegative = false;
+        return;
+    }
+    if (limbs2.size() == 1) {
+        Limb divisor = limbs2[0];
+        quotient = bnum1;
+        quotient.isNegative = false;
+        Limb rem = quotient.divideByLimb(divisor);
+        remainder.clear();
+        if (rem != 0) {
+            remainder.digits.push_back(rem);
+        }
+        return;
+    }
+    if (limbs2.size() >= kNewtonThreshold &&
+        limbs1.size() >= limbs2.size() + kNewtonThreshold) {
+        BigInteger divisor = bnum2;
+        divisor.isNegative = false;
+        divModNewton(bnum1, divisor, reciprocal(divisor), quotient, remainder);
+        return;
+    }
+    quotient.digits.resize(limbs1.size() - limbs2.size() + 1);
+    remainder.digits.resize(limbs2.size());
+    divKnuth(limbs1.data(), limbs1.size(), limbs2.data(), limbs2.size(),
+             quotient.digits.data(), remainder.digits.data());
+    quotient.isNegative = remainder.isNegative = false;
+    quotient.removeLeadingZeros();
+    remainder.removeLeadingZeros();
+}
+
+const std::pair<BigInteger, BigInteger>& BigInteger::decPower(size_t level) {
+    static std::mutex mutex;
+    static std::deque<std::pair<BigInteger, BigInteger>> powers;
+    std::lock_guard<std::mutex> lock(mutex);
+    BigIntegerMemoryScope scope(std::pmr::new_delete_resource());
+    if (powers.empty()) {
+        powers.emplace_back(BigInteger(static_cast<int>(kDecNumSys)), BigInteger());
+    }
+    while (powers.size() <= level) {
+        BigInteger power = powers.back().first * powers.back().first;
+        BigInteger recip;
+        if (power.digits.size() >= kNewtonThreshold) {
+            recip = reciprocal(power);
+        }
+        powers.emplace_back(std::move(power), std::move(recip));
+    }
+    return powers[level];
+}
+
+void BigInteger::divModDecPower(const BigInteger& bnum, size_t level,
+                                BigInteger& quotient, BigInteger& remainder) {
+    const std::pair<BigInteger, BigInteger>& power = decPower(level);
+    if (power.second && bnum.digits.size() <= 2 * power.first.digits.size()) {
+        divModNewton(bnum, power.first, power.second, quotient, remainder);
+    } else {
+        divModAbs(bnum, power.first, quotient, remainder);
+    }
+}
+
+char* BigInteger::writeDecimal(const BigInteger& bnum, char* buf) {
+    if (bnum.digits.size() <= kConversionThreshold) {
+        BigInteger copy(bnum);
+        Limb chunks[2 * kConversionThreshold];
+        size_t count = 0;
+        while (!copy.digits.empty()) {
+            chunks[count++] = copy.divideByLimb(kDecNumSys);
+        }
+        buf = std::to_chars(buf, buf + kDigLen, chunks[count - 1]).ptr;
+        for (size_t i = count - 1; i-- > 0;) {
+            for (size_t j = kDigLen; j-- > 0;) {
+                buf[j] = '0' + chunks[i] % 10;
+                chunks[i] /= 10;
+            }
+            buf += kDigLen;
+        }
+        return buf;
+    }
+    size_t level = 0;
+    while (true) {
+        const LimbBuffer& power = decPower(level + 1).first.digits;
+        if (compareLimbs(power.data(), power.size(), bnum.digits.data(),
+                         bnum.digits.size()) > 0) {
+            break;
+        }
+        ++level;
+    }
+    BigInteger quotient, remainder;
+    divModDecPower(bnum, level, quotient, remainder);
+    buf = writeDecimal(quotient, buf);
+    return writeDecimalPadded(remainder, level, buf);
+}
+
+char* BigInteger::writeDecimalPadded(const BigInteger& bnum, size_t level,
+                                     char* buf) {
+    size_t len = kDigLen << level;
+    if (level == 0 || bnum.digits.size() <= kConversionThreshold) {
+        BigInteger copy(bnum);
+        for (size_t pos = len; pos > 0; pos -= kDigLen) {
+            Limb chunk = copy.digits.empty() ? 0
+                                             : copy.divideByLimb(kDecNumSys);
+            for (size_t j = 1; j <= kDigLen; ++j) {
+                buf[pos - j] = '0' + chunk % 10;
+                chunk /= 10;
+            }
+        }
+        return buf + len;
+    }
+    BigInteger quotient, remainder;
+    divModDecPower(bnum, level - 1, quotient, remainder);
+    writeDecimalPadded(quotient, level - 1, buf);
+    return writeDecimalPadded(remainder, level - 1, buf + len / 2);
+}
+
+BigInteger BigInteger::parseDecimal(std::string_view str) {
+    BigInteger res;
+    if (str.size() <= kConversionThreshold * kDigLen) {
+        Limb now_dig = 0, mul = 1;
+        for (size_t i = 0; i < str.size(); ++i) {
+            now_dig = now_dig * 10 + str[i] - '0';
+            mul *= 10;
+            if ((str.size() - i - 1) % kDigLen == 0) {
+                res.mulAddLimb(mul, now_dig);
+                now_dig = 0;
+                mul = 1;
+            }
+        }
+        res.removeLeadingZeros();
+        return res;
+    }
+    size_t level = 0;
+    while ((kDigLen << (level + 1)) < str.size()) {
+        ++level;
+    }
+    size_t low_len = kDigLen << level;
+    res = parseDecimal(str.substr(0, str.size() - low_len));
+    res *= decPower(level).first;
+    res += parseDecimal(str.substr(str.size() - low_len));
+    return res;
+}
+
+BigInteger BigInteger::fromWord(DoubleLimb num, bool negative) {
+    BigInteger res;
+    res.isNegative = negative;
+    for (; num != 0; num /= kNumSys) {
+        res.digits.push_back(num % kNumSys);
+    }
+    return res;
+}
+
+BigInteger::DoubleLimb BigInteger::lowWord() const {
+    DoubleLimb res = digits.empty() ? 0 : digits[0];
+    if (digits.size() > 1) {
+        res += digits[1] * kNumSys;
+    }
+    return res;
+}
+
+size_t BigInteger::bitLength() const {
+    if (digits.empty()) {
+        return 0;
+    }
+    return 32 * digits.size() - std::countl_zero(digits[digits.size() - 1]);
+}
+
+BigInteger::DoubleLimb BigInteger::topBits(size_t shift) const {
+    unsigned __int128 res = 0;
+    for (size_t i = std::min(digits.size(), shift / 32 + 3); i-- > shift / 32;) {
+        res = res << 32 | digits[i];
+    }
+    return static_cast<DoubleLimb>(res >> shift % 32);
+}
+
+void BigInteger::addWord(DoubleLimb num, bool negative) {
+    Limb limbs[2] = {static_cast<Limb>(num), static_cast<Limb>(num >> 32)};
+    addSigned(limbs, limbs[1] != 0 ? 2 : limbs[0] != 0 ? 1 : 0, negative);
+}
+
+void BigInteger::mulWord(DoubleLimb num, bool negative) {
+    isNegative = isNegative != negative;
+    if (num == 0) {
+        digits.clear();
+    } else if (num < kNumSys) {
+        mulAddLimb(num, 0);
+    } else {
+        (*this) *= fromWord(num);
+    }
+}
+
+BigInteger::DoubleLimb BigInteger::divWord(DoubleLimb num) {
+    if (num == 0) {
+        throw std::domain_error("");
+    }
+    if (num < kNumSys) {
+        return divideByLimb(num);
+    }
+    BigInteger quotient, remainder;
+    divModAbs(*this, fromWord(num), quotient, remainder);
+    digits.adopt(quotient.digits);
+    return remainder.lowWord();
+}
+
+template <class Op>
+void BigInteger::applyBitwise(const BigInteger& bnum, Op op) {
+    bool negative1 = isNegative && !digits.empty();
+    bool negative2 = bnum.isNegative && !bnum.digits.empty();
+    bool res_negative = op(Limb(negative1), Limb(negative2)) != 0;
+    auto complement = [](Limb limb, bool negative, Limb& carry) {
+        if (!negative) {
+            return limb;
+        }
+        Limb res = ~limb + carry;
+        carry = res == 0 ? carry : 0;
+        return res;
+    };
+    Limb carry1 = 1, carry2 = 1, res_carry = 1;
+    size_t len = std::max(digits.size(), bnum.digits.size());
+    digits.resize(len);
+    for (size_t i = 0; i < len; ++i) {
+        Limb limb1 = complement(digits[i], negative1, carry1);
+        Limb limb2 = complement(i < bnum.digits.size() ? bnum.digits[i] : 0,
+                                negative2, carry2);
+        digits[i] = complement(op(limb1, limb2), res_negative, res_carry);
+    }
+    if (res_negative && res_carry != 0) {
+        digits.push_back(1);
+    }
+    isNegative = res_negative;
+    removeLeadingZeros();
+}
+
+BigInteger::DoubleLimb BigInteger::gcdWord(DoubleLimb num1, DoubleLimb num2) {
+    if (num1 == 0 || num2 == 0) {
+        return num1 | num2;
+    }
+    int shift = std::countr_zero(num1 | num2);
+    num1 >>= std::countr_zero(num1);
+    do {
+        num2 >>= std::countr_zero(num2);
+        if (num1 > num2) {
+            std::swap(num1, num2);
+        }
+        num2 -= num1;
+    } while (num2 != 0);
+    return num1 << shift;
+}
 
-void BigInteger::swap(BigInteger& bnum) {
-    std::swap(isNegative, bnum.isNegative);
-    std::swap(digits, bnum.digits);
+void BigInteger::applyLehmer(BigInteger& bnum1, BigInteger& bnum2, int64_t a,
+                             int64_t b, int64_t c, int64_t d) {
+    bnum2.digits.resize(bnum1.digits.size());
+    __int128 transf1 = 0, transf2 = 0;
+    for (size_t i = 0; i < bnum1.digits.size(); ++i) {
+        transf1 += static_cast<__int128>(a) * bnum1.digits[i] +
+                   static_cast<__int128>(b) * bnum2.digits[i];
+        transf2 += static_cast<__int128>(c) * bnum1.digits[i] +
+                   static_cast<__int128>(d) * bnum2.digits[i];
+        bnum1.digits[i] = static_cast<Limb>(transf1);
+        bnum2.digits[i] = static_cast<Limb>(transf2);
+        transf1 >>= 32;
+        transf2 >>= 32;
+    }
+    bnum1.removeLeadingZeros();
+    bnum2.removeLeadingZeros();
 }
 
-void BigInteger::removeLeadingZeros() {
-    while (!digits.empty() && digits.back() == 0) {
-        digits.pop_back();
+BigInteger BigInteger::gcdLehmer(BigInteger bnum1, BigInteger bnum2,
+                                 BigInteger* coef) {
+    BigInteger coef1(1), coef2(0);
+    if (bnum1 < bnum2) {
+        bnum1.swap(bnum2);
+        coef1.swap(coef2);
+    }
+    while (bnum2.digits.size() > 2) {
+        size_t shift = bnum1.bitLength() - 62;
+        int64_t top1 = bnum1.topBits(shift), top2 = bnum2.topBits(shift);
+        int64_t a = 1, b = 0, c = 0, d = 1;
+        while (top2 + c != 0 && top2 + d != 0) {
+            int64_t quot = (top1 + a) / (top2 + c);
+            if (quot != (top1 + b) / (top2 + d)) {
+                break;
+            }
+            int64_t tmp = a - quot * c;
+            a = c;
+            c = tmp;
+            tmp = b - quot * d;
+            b = d;
+            d = tmp;
+            tmp = top1 - quot * top2;
+            top1 = top2;
+            top2 = tmp;
+        }
+        if (b == 0) {
+            BigInteger quot, rem;
+            divModAbs(bnum1, bnum2, quot, rem);
+            bnum1.swap(bnum2);
+            bnum2.swap(rem);
+            if (coef != nullptr) {
+                coef1 -= quot * coef2;
+                coef1.swap(coef2);
+            }
+            continue;
+        }
+        applyLehmer(bnum1, bnum2, a, b, c, d);
+        if (coef != nullptr) {
+            BigInteger new_coef1 = coef1 * fromWord(std::abs(a), a < 0) +
+                                   coef2 * fromWord(std::abs(b), b < 0),
+                       new_coef2 = coef1 * fromWord(std::abs(c), c < 0) +
+                                   coef2 * fromWord(std::abs(d), d < 0);
+            coef1.swap(new_coef1);
+            coef2.swap(new_coef2);
+        }
+    }
+    if (coef == nullptr) {
+        if (bnum2.digits.empty()) {
+            return bnum1;
+        }
+        BigInteger quot, rem;
+        divModAbs(bnum1, bnum2, quot, rem);
+        return fromWord(gcdWord(bnum2.lowWord(), rem.lowWord()));
+    }
+    while (bnum2) {
+        BigInteger quot, rem;
+        divModAbs(bnum1, bnum2, quot, rem);
+        bnum1.swap(bnum2);
+        bnum2.swap(rem);
+        coef1 -= quot * coef2;
+        coef1.swap(coef2);
     }
+    coef->swap(coef1);
+    return bnum1;
 }
 
-BigInteger::BigInteger() : isNegative(false) {}
+BigInteger::DoubleLimb BigInteger::rootWord(DoubleLimb num,
+                                            unsigned degree) {
+    auto fits = [num, degree](DoubleLimb root) {
+        unsigned __int128 power = 1;
+        for (unsigned i = 0; i < degree; ++i) {
+            power *= root;
+            if (power > num) {
+                return false;
+            }
+        }
+        return true;
+    };
+    DoubleLimb res = std::pow(static_cast<double>(num), 1.0 / degree);
+    while (res > 0 && !fits(res)) {
+        --res;
+    }
+    while (fits(res + 1)) {
+        ++res;
+    }
+    return res;
+}
 
-BigInteger::BigInteger(int num) : isNegative(num < 0) {
-    num = std::abs(num);
-    while (num > 0) {
-        digits.push_back(num % kNumSys);
-        num /= kNumSys;
+BigInteger BigInteger::rootNewton(const BigInteger& bnum, unsigned degree) {
+    size_t len = bnum.limbCount();
+    if (len <= 2) {
+        return fromWord(rootWord(bnum.lowWord(), degree));
+    }
+    BigInteger res;
+    size_t shift = len / (2 * degree);
+    if (shift == 0) {
+        res = pow(BigInteger(2), (bnum.bitLength() + degree - 1) / degree);
+    } else {
+        res = rootNewton(bnum.limbSlice(degree * shift, len), degree);
+        res += 1;
+        res.shiftLimbs(shift);
+    }
+    while (true) {
+        BigInteger next = bnum / pow(res, degree - 1);
+        next += res * (degree - 1);
+        next /= degree;
+        if (next >= res) {
+            return res;
+        }
+        if (pow(next, degree) <= bnum) {
+            return next;
+        }
+        res.swap(next);
+    }
+}
+
+BigInteger BigInteger::reduceMod(const BigInteger& bnum,
+                                 const BigInteger& mod) {
+    BigInteger quotient, res;
+    divModAbs(bnum, mod, quotient, res);
+    if (bnum.isNegative && res) {
+        BigInteger complement = mod;
+        complement.isNegative = false;
+        complement -= res;
+        return complement;
     }
+    return res;
 }
 
-BigInteger::BigInteger(std::string s) : isNegative(s.front() == '-') {
-    int start = static_cast<int>(s.front() == '-');
-    for (int i = static_cast<int>(s.size()) - 1; i >= start; i -= kDigLen) {
-        int now_dig = 0;
-        for (int j = std::max(i - kDigLen + 1, start); j <= i; ++j) {
-            now_dig = now_dig * 10 + s[j] - '0';
+template <class Mul>
+BigInteger BigInteger::powWindow(const BigInteger& base, const BigInteger& exp,
+                                 const BigInteger& one, Mul mul) {
+    size_t bits = exp.bitLength();
+    size_t window = bits > 671  ? 6
+                    : bits > 239 ? 5
+                    : bits > 79  ? 4
+                    : bits > 23  ? 3
+                                 : 1;
+    std::vector<BigInteger> odd_powers(size_t(1) << (window - 1));
+    odd_powers[0] = base;
+    if (window > 1) {
+        BigInteger base_square = mul(base, base);
+        for (size_t i = 1; i < odd_powers.size(); ++i) {
+            odd_powers[i] = mul(odd_powers[i - 1], base_square);
+        }
+    }
+    auto bit = [&exp](size_t pos) {
+        return (exp.digits[pos / 32] >> (pos % 32) & 1) != 0;
+    };
+    BigInteger res = one;
+    bool started = false;
+    for (size_t pos = bits; pos > 0;) {
+        if (!bit(pos - 1)) {
+            res = mul(res, res);
+            --pos;
+            continue;
+        }
+        size_t low = pos > window ? pos - window : 0;
+        while (!bit(low)) {
+            ++low;
+        }
+        size_t value = 0;
+        for (size_t i = pos; i-- > low;) {
+            value = value << 1 | static_cast<size_t>(bit(i));
+        }
+        if (started) {
+            for (size_t i = low; i < pos; ++i) {
+                res = mul(res, res);
+            }
+            res = mul(res, odd_powers[value >> 1]);
+        } else {
+            res = odd_powers[value >> 1];
+            started = true;
         }
-        digits.push_back(now_dig);
+        pos = low;
     }
+    return res;
 }
 
-BigInteger::operator bool() const {
-    return !digits.empty();
+BigInteger::BigInteger() : isNegative(false) {}
+
+BigInteger::BigInteger(std::pmr::memory_resource* resource)
+    : isNegative(false), digits(resource) {}
+
+BigInteger::BigInteger(const BigInteger& bnum,
+                       std::pmr::memory_resource* resource)
+    : isNegative(bnum.isNegative), digits(resource) {
+    digits.assign(bnum.digits.begin(), bnum.digits.end());
 }
 
-const int& BigInteger::operator[](size_t pos) const {
-    return digits[pos];
+BigInteger::BigInteger(int num) : isNegative(num < 0) {
+    Limb abs_num = num < 0 ? -static_cast<Limb>(num) : num;
+    if (abs_num != 0) {
+        digits.push_back(abs_num);
+    }
+}
+
+BigInteger::BigInteger(std::string s) : BigInteger(fromChars(s)) {}
+
+BigInteger::operator bool() const {
+    return !digits.empty();
 }
 
-int& BigInteger::operator[](size_t pos) {
+uint32_t BigInteger::limb(size_t pos) const {
     return digits[pos];
 }
 
-size_t BigInteger::numLength() const {
+size_t BigInteger::limbCount() const {
     return digits.size();
 }
 
@@ -63,12 +1570,27 @@ void BigInteger::clear() {
     digits.clear();
 }
 
-BigInteger BigInteger::operator-() const {
+void BigInteger::negate() {
+    isNegative = !isNegative;
+}
+
+BigInteger BigInteger::operator-() const& {
     BigInteger copy(*this);
     copy.isNegative = !copy.isNegative;
     return copy;
 }
 
+BigInteger BigInteger::operator-() && {
+    isNegative = !isNegative;
+    return std::move(*this);
+}
+
+BigInteger BigInteger::operator~() const {
+    BigInteger res = -(*this);
+    res -= 1;
+    return res;
+}
+
 BigInteger& BigInteger::operator++() {
     return (*this) += 1;
 }
@@ -90,297 +1612,734 @@ BigInteger BigInteger::operator--(int) {
 }
 
 BigInteger& BigInteger::operator+=(const BigInteger& bnum) {
-    if (isNegative != bnum.isNegative) {
-        isNegative = !isNegative;
-        (*this) -= bnum;
-        isNegative = !isNegative;
+    addSigned(bnum.digits.data(), bnum.digits.size(), bnum.isNegative);
+    return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigInteger& bnum) {
+    addSigned(bnum.digits.data(), bnum.digits.size(), !bnum.isNegative);
+    return *this;
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& bnum) {
+    static thread_local LimbBuffer product(std::pmr::new_delete_resource());
+    bool res_negative = isNegative != bnum.isNegative;
+    mulMagnitudes(*this, bnum, product);
+    digits.adopt(product);
+    isNegative = res_negative;
+    return *this;
+}
+
+BigInteger& BigInteger::operator&=(const BigInteger& bnum) {
+    applyBitwise(bnum, [](Limb limb1, Limb limb2) { return limb1 & limb2; });
+    return *this;
+}
+
+BigInteger& BigInteger::operator|=(const BigInteger& bnum) {
+    applyBitwise(bnum, [](Limb limb1, Limb limb2) { return limb1 | limb2; });
+    return *this;
+}
+
+BigInteger& BigInteger::operator^=(const BigInteger& bnum) {
+    applyBitwise(bnum, [](Limb limb1, Limb limb2) { return limb1 ^ limb2; });
+    return *this;
+}
+
+BigInteger& BigInteger::operator<<=(size_t shift) {
+    if (digits.empty()) {
         return *this;
     }
-    while (digits.size() < bnum.digits.size()) {
-        digits.push_back(0);
+    size_t bits = shift % 32;
+    if (bits != 0) {
+        Limb top = 0;
+        for (size_t i = 0; i < digits.size(); ++i) {
+            Limb next = digits[i] >> (32 - bits);
+            digits[i] = digits[i] << bits | top;
+            top = next;
+        }
+        if (top != 0) {
+            digits.push_back(top);
+        }
     }
-    long long transf = 0;
-    for (size_t i = 0; i < bnum.digits.size(); ++i) {
-        transf += digits[i] + bnum.digits[i];
-        if (transf < kNumSys) {
-            digits[i] = transf;
-            transf = 0;
-        } else {
-            digits[i] = transf - kNumSys;
-            transf = 1;
+    shiftLimbs(shift / 32);
+    return *this;
+}
+
+BigInteger& BigInteger::operator>>=(size_t shift) {
+    size_t limbs = shift / 32, bits = shift % 32;
+    bool dropped = false;
+    if (limbs >= digits.size()) {
+        dropped = !digits.empty();
+        digits.clear();
+    } else {
+        for (size_t i = 0; i < limbs && !dropped; ++i) {
+            dropped = digits[i] != 0;
         }
+        dropped = dropped || (digits[limbs] & ((Limb(1) << bits) - 1)) != 0;
+        for (size_t i = limbs; i < digits.size(); ++i) {
+            Limb next = i + 1 < digits.size() ? digits[i + 1] : 0;
+            digits[i - limbs] =
+                bits == 0 ? digits[i] : digits[i] >> bits | next << (32 - bits);
+        }
+        digits.resize(digits.size() - limbs);
+        removeLeadingZeros();
     }
-    if (transf != 0 && digits.size() == bnum.digits.size()) {
-        digits.push_back(transf);
-    } else if (transf != 0) {
-        digits[bnum.digits.size()] += transf;
+    if (isNegative && dropped) {
+        addWord(1, true);
     }
     return *this;
 }
 
-BigInteger& BigInteger::operator-=(const BigInteger& bnum) {
-    if (isNegative != bnum.isNegative) {
-        isNegative = !isNegative;
-        (*this) += bnum;
-        isNegative = !isNegative;
-        return *this;
+size_t BigInteger::popcount() const {
+    size_t res = 0;
+    for (Limb limb : digits) {
+        res += std::popcount(limb);
     }
-    while (digits.size() < bnum.digits.size()) {
-        digits.push_back(0);
+    return res;
+}
+
+void BigInteger::reserve(size_t limbs) {
+    digits.reserve(limbs);
+}
+
+BigInteger& BigInteger::addmul(const BigInteger& bnum1,
+                               const BigInteger& bnum2) {
+    static thread_local LimbBuffer product(std::pmr::new_delete_resource());
+    mulMagnitudes(bnum1, bnum2, product);
+    addSigned(product.data(), product.size(),
+              bnum1.isNegative != bnum2.isNegative);
+    return *this;
+}
+
+BigInteger& BigInteger::submul(const BigInteger& bnum1,
+                               const BigInteger& bnum2) {
+    static thread_local LimbBuffer product(std::pmr::new_delete_resource());
+    mulMagnitudes(bnum1, bnum2, product);
+    addSigned(product.data(), product.size(),
+              bnum1.isNegative == bnum2.isNegative);
+    return *this;
+}
+
+std::string BigInteger::toString() const {
+    std::string res(maxCharsLength(), '\0');
+    res.resize(toChars(res.data()) - res.data());
+    return res;
+}
+
+size_t BigInteger::maxCharsLength() const {
+    return 1 + std::max<size_t>(1, 10 * digits.size());
+}
+
+char* BigInteger::toChars(char* buf) const {
+    if (digits.empty()) {
+        *buf = '0';
+        return buf + 1;
     }
-    for (size_t i = 0; i < bnum.digits.size(); ++i) {
-        digits[i] -= bnum.digits[i];
+    if (isNegative) {
+        *buf++ = '-';
     }
-    int first_positive = -1, first_negative = -1;
-    for (size_t i = 0; i < digits.size(); ++i) {
-        if (digits[i] < 0) {
-            first_negative = i;
-        }
-        if (digits[i] > 0) {
-            first_positive = i;
-        }
+    return writeDecimal(*this, buf);
+}
+
+BigInteger BigInteger::fromChars(std::string_view str) {
+    bool negative = !str.empty() && str.front() == '-';
+    if (!str.empty() && (str.front() == '-' || str.front() == '+')) {
+        str.remove_prefix(1);
     }
-    if (first_positive < first_negative) {
-        isNegative = !isNegative;
-        for (size_t i = 0; i < digits.size(); ++i) {
-            digits[i] *= -1;
-        }
+    BigInteger res = parseDecimal(str);
+    res.isNegative = negative && res;
+    return res;
+}
+
+size_t BigInteger::serializedSize() const {
+    size_t header = digits.size() << 1 | static_cast<size_t>(isNegative);
+    return (std::bit_width(header | 1) + 6) / 7 +
+           sizeof(Limb) * digits.size();
+}
+
+size_t BigInteger::serialize(std::span<std::byte> buf) const {
+    size_t size = serializedSize();
+    if (buf.size() < size) {
+        throw std::out_of_range("");
     }
-    bool need_help = false;
-    for (size_t i = 0; i < digits.size(); ++i) {
-        if (need_help && digits[i] <= 0) {
-            digits[i] += kNumSys - 1;
-        } else if (need_help) {
-            --digits[i];
-            need_help = false;
-        } else if (digits[i] < 0) {
-            digits[i] += kNumSys;
-            need_help = true;
+    size_t header = digits.size() << 1 | static_cast<size_t>(isNegative);
+    size_t pos = 0;
+    for (; header >= 0x80; header >>= 7) {
+        buf[pos++] = static_cast<std::byte>(header | 0x80);
+    }
+    buf[pos++] = static_cast<std::byte>(header);
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(buf.data() + pos, digits.data(),
+                    sizeof(Limb) * digits.size());
+    } else {
+        for (size_t i = 0; i < digits.size(); ++i) {
+            for (size_t j = 0; j < sizeof(Limb); ++j) {
+                buf[pos + sizeof(Limb) * i + j] =
+                    static_cast<std::byte>(digits[i] >> (8 * j));
+            }
         }
     }
-    removeLeadingZeros();
-    return *this;
+    return size;
 }
 
-BigInteger& BigInteger::operator*=(const BigInteger& bnum) {
-    BigInteger res;
-    for (size_t i = 0; i < bnum.digits.size(); ++i) {
-        BigInteger now_res;
-        long long transf = 0;
-        for (size_t j = 0; j < digits.size(); ++j) {
-            transf += static_cast<long long>(digits[j]) * bnum.digits[i];
-            now_res.digits.push_back(transf % kNumSys);
-            transf /= kNumSys;
+size_t BigInteger::deserialize(std::span<const std::byte> buf) {
+    size_t header = 0, pos = 0;
+    for (int shift = 0;; shift += 7) {
+        if (pos == buf.size() || shift >= 64) {
+            throw std::out_of_range("");
         }
-        if (transf != 0) {
-            now_res.digits.push_back(transf);
+        size_t now = std::to_integer<size_t>(buf[pos++]);
+        header |= (now & 0x7F) << shift;
+        if (now < 0x80) {
+            break;
         }
-        now_res.removeLeadingZeros();
-        if (now_res.digits.empty()) {
-            continue;
+    }
+    size_t len = header >> 1;
+    if ((buf.size() - pos) / sizeof(Limb) < len) {
+        throw std::out_of_range("");
+    }
+    isNegative = (header & 1) != 0;
+    digits.resize(len);
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(digits.data(), buf.data() + pos, sizeof(Limb) * len);
+    } else {
+        for (size_t i = 0; i < len; ++i) {
+            digits[i] = 0;
+            for (size_t j = 0; j < sizeof(Limb); ++j) {
+                digits[i] |= std::to_integer<Limb>(
+                                 buf[pos + sizeof(Limb) * i + j])
+                             << (8 * j);
+            }
         }
-        for (size_t j = 0; j < i; ++j) {
-            now_res.siftLeft();
+    }
+    removeLeadingZeros();
+    return pos + sizeof(Limb) * len;
+}
+
+std::pmr::memory_resource* BigInteger::memoryResource() const {
+    return digits.memoryResource();
+}
+
+void BigInteger::siftLeft() {
+    mulAddLimb(kDecNumSys, 0);
+}
+
+std::istream& operator>>(std::istream& in, BigInteger& bnum) {
+    bnum.clear();
+    std::string s;
+    in >> s;
+    bnum = BigInteger(s);
+    return in;
+}
+
+std::ostream& operator<<(std::ostream& out, const BigInteger& bnum) {
+    return out << bnum.toString();
+}
+
+bool operator==(const BigInteger& bnum1, const BigInteger& bnum2) {
+    if (bnum1.limbCount() != bnum2.limbCount()) {
+        return false;
+    }
+    if (bnum1.limbCount() == 0) {
+        return true;
+    }
+    if (bnum1.numSign() != bnum2.numSign()) {
+        return false;
+    }
+    return BigInteger::compareLimbs(bnum1.digits.data(), bnum1.digits.size(),
+                                    bnum2.digits.data(),
+                                    bnum2.digits.size()) == 0;
+}
+
+bool operator!=(const BigInteger& bnum1, const BigInteger& bnum2) {
+    return !(bnum1 == bnum2);
+}
+
+bool operator<(const BigInteger& bnum1, const BigInteger& bnum2) {
+    if (bnum1.limbCount() == 0) {
+        if (bnum2.limbCount() == 0) {
+            return false;
         }
-        res += now_res;
+        return bnum2.numSign() == 1;
+    }
+    if (bnum2.limbCount() == 0) {
+        return bnum1.numSign() != 1;
+    }
+    if (bnum1.numSign() != bnum2.numSign()) {
+        return bnum1.numSign() < bnum2.numSign();
+    }
+    int res = BigInteger::compareLimbs(bnum1.digits.data(), bnum1.digits.size(),
+                                       bnum2.digits.data(),
+                                       bnum2.digits.size());
+    return bnum1.numSign() == 1 ? res < 0 : res > 0;
+}
+
+bool operator>=(const BigInteger& bnum1, const BigInteger& bnum2) {
+    return !(bnum1 < bnum2);
+}
+
+bool operator>(const BigInteger& bnum1, const BigInteger& bnum2) {
+    return bnum2 < bnum1;
+}
+
+bool operator<=(const BigInteger& bnum1, const BigInteger& bnum2) {
+    return !(bnum2 < bnum1);
+}
+
+BigInteger operator+(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 += bnum2;
+    return bnum1;
+}
+
+BigInteger operator+(const BigInteger& bnum1, BigInteger&& bnum2) {
+    bnum2 += bnum1;
+    if (!bnum2 && bnum2.numSign() != bnum1.numSign()) {
+        return -std::move(bnum2);
     }
-    res.isNegative = isNegative;
-    if (bnum.isNegative) {
-        res.isNegative = !res.isNegative;
+    return std::move(bnum2);
+}
+
+BigInteger operator+(BigInteger&& bnum1, BigInteger&& bnum2) {
+    bnum1 += bnum2;
+    return std::move(bnum1);
+}
+
+BigInteger operator-(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 -= bnum2;
+    return bnum1;
+}
+
+BigInteger operator*(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 *= bnum2;
+    return bnum1;
+}
+
+BigInteger operator*(const BigInteger& bnum1, BigInteger&& bnum2) {
+    bnum2 *= bnum1;
+    return std::move(bnum2);
+}
+
+BigInteger operator*(BigInteger&& bnum1, BigInteger&& bnum2) {
+    bnum1 *= bnum2;
+    return std::move(bnum1);
+}
+
+BigInteger& BigInteger::operator/=(const BigInteger& bnum) {
+    static thread_local BigInteger quotient(std::pmr::new_delete_resource()),
+        remainder(std::pmr::new_delete_resource());
+    divModAbs(*this, bnum, quotient, remainder);
+    isNegative = isNegative != bnum.isNegative;
+    digits.adopt(quotient.digits);
+    return *this;
+}
+
+BigInteger& BigInteger::operator%=(const BigInteger& bnum) {
+    static thread_local BigInteger quotient(std::pmr::new_delete_resource()),
+        remainder(std::pmr::new_delete_resource());
+    divModAbs(*this, bnum, quotient, remainder);
+    isNegative = isNegative != bnum.isNegative;
+    digits.adopt(remainder.digits);
+    return *this;
+}
+
+BigInteger operator/(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 /= bnum2;
+    return bnum1;
+}
+
+BigInteger operator%(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 %= bnum2;
+    return bnum1;
+}
+
+BigInteger operator&(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 &= bnum2;
+    return bnum1;
+}
+
+BigInteger operator|(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 |= bnum2;
+    return bnum1;
+}
+
+BigInteger operator^(BigInteger bnum1, const BigInteger& bnum2) {
+    bnum1 ^= bnum2;
+    return bnum1;
+}
+
+BigInteger operator<<(BigInteger bnum, size_t shift) {
+    bnum <<= shift;
+    return bnum;
+}
+
+BigInteger operator>>(BigInteger bnum, size_t shift) {
+    bnum >>= shift;
+    return bnum;
+}
+
+BigInteger multiply(const BigInteger& bnum1, const BigInteger& bnum2,
+                    size_t threads) {
+    BigInteger res;
+    BigInteger::mulMagnitudes(bnum1, bnum2, res.digits,
+                              std::max<size_t>(threads, 1));
+    res.isNegative = bnum1.isNegative != bnum2.isNegative;
+    return res;
+}
+
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& bnum1,
+                                         const BigInteger& bnum2) {
+    std::pair<BigInteger, BigInteger> res;
+    BigInteger::divModAbs(bnum1, bnum2, res.first, res.second);
+    res.first.isNegative = res.second.isNegative =
+        bnum1.isNegative != bnum2.isNegative;
+    return res;
+}
+
+BigInteger gcd(const BigInteger& bnum1, const BigInteger& bnum2) {
+    BigInteger abs1 = bnum1, abs2 = bnum2;
+    abs1.isNegative = abs2.isNegative = false;
+    if (abs1.digits.size() <= 2 && abs2.digits.size() <= 2) {
+        return BigInteger::fromWord(
+            BigInteger::gcdWord(abs1.lowWord(), abs2.lowWord()));
     }
-    swap(res);
-    return *this;
+    return BigInteger::gcdLehmer(abs1, abs2, nullptr);
 }
 
-std::string BigInteger::toString() const {
-    if (digits.empty()) {
-        return "0";
+BigInteger extendedGcd(const BigInteger& bnum1, const BigInteger& bnum2,
+                       BigInteger& coef1, BigInteger& coef2) {
+    BigInteger abs1 = bnum1, abs2 = bnum2;
+    abs1.isNegative = abs2.isNegative = false;
+    BigInteger res = BigInteger::gcdLehmer(abs1, abs2, &coef1);
+    if (abs2) {
+        coef2 = (res - coef1 * abs1) / abs2;
+    } else {
+        coef2 = 0;
     }
-    std::string res;
-    if (isNegative) {
-        res.push_back('-');
+    if (bnum1.isNegative) {
+        coef1 = -coef1;
     }
-    res += std::to_string(digits.back());
-    for (int i = static_cast<int>(digits.size()) - 2; i >= 0; --i) {
-        std::string now_dig = std::to_string(digits[i]);
-        for (size_t j = now_dig.size(); j < kDigLen; ++j) {
-            res.push_back('0');
-        }
-        res += now_dig;
+    if (bnum2.isNegative) {
+        coef2 = -coef2;
     }
     return res;
 }
 
-void BigInteger::siftLeft() {
-    if (!digits.empty()) {
-        digits.push_front(0);
+BigInteger lcm(const BigInteger& bnum1, const BigInteger& bnum2) {
+    if (!bnum1 || !bnum2) {
+        return 0;
     }
+    BigInteger res = bnum1 / gcd(bnum1, bnum2) * bnum2;
+    return res.numSign() == -1 ? -res : res;
 }
 
-BigInteger operator""_bi(unsigned long long num) {
-    return BigInteger(std::to_string(num));
-}
-
-BigInteger operator""_bi(const char* str, size_t /*unused*/) {
-    return BigInteger(std::string(str));
-}
-
-std::istream& operator>>(std::istream& in, BigInteger& bnum) {
-    bnum.clear();
-    std::string s;
-    in >> s;
-    bnum = BigInteger(s);
-    return in;
+BigInteger pow(const BigInteger& base, uint64_t exp) {
+    BigInteger res(1);
+    for (int bit = std::bit_width(exp); bit-- > 0;) {
+        res *= res;
+        if ((exp >> bit & 1) != 0) {
+            res *= base;
+        }
+    }
+    return res;
 }
 
-std::ostream& operator<<(std::ostream& out, const BigInteger& bnum) {
-    return out << bnum.toString();
+BigInteger isqrt(const BigInteger& bnum) {
+    return iroot(bnum, 2);
 }
 
-bool operator==(const BigInteger& bnum1, const BigInteger& bnum2) {
-    if (bnum1.numLength() != bnum2.numLength()) {
-        return false;
+BigInteger iroot(const BigInteger& bnum, unsigned degree) {
+    if (degree == 0 || (bnum.isNegative && bnum && degree % 2 == 0)) {
+        throw std::domain_error("");
     }
-    if (bnum1.numLength() == 0) {
-        return true;
+    if (degree == 1) {
+        return bnum;
     }
-    if (bnum1.numSign() != bnum2.numSign()) {
-        return false;
+    BigInteger abs = bnum;
+    abs.isNegative = false;
+    BigInteger res = BigInteger::rootNewton(abs, degree);
+    res.isNegative = bnum.isNegative && bnum;
+    return res;
+}
+
+std::vector<uint64_t> BigInteger::primesUpTo(uint64_t num) {
+    std::vector<uint64_t> primes;
+    if (num < 2) {
+        return primes;
     }
-    for (size_t i = 0; i < bnum1.numLength(); ++i) {
-        if (bnum1[i] != bnum2[i]) {
-            return false;
+    primes.push_back(2);
+    std::vector<bool> composite(num / 2 + 1);
+    for (uint64_t i = 3; i <= num; i += 2) {
+        if (composite[i / 2]) {
+            continue;
+        }
+        primes.push_back(i);
+        for (uint64_t j = i * i; j <= num; j += 2 * i) {
+            composite[j / 2] = true;
         }
     }
-    return true;
+    return primes;
 }
 
-bool operator!=(const BigInteger& bnum1, const BigInteger& bnum2) {
-    return !(bnum1 == bnum2);
+BigInteger BigInteger::productOfWords(const std::vector<DoubleLimb>& words,
+                                      size_t threads) {
+    std::vector<BigInteger> factors;
+    DoubleLimb acc = 1;
+    for (DoubleLimb word : words) {
+        if (acc > UINT64_MAX / word) {
+            factors.push_back(fromWord(acc));
+            acc = 1;
+        }
+        acc *= word;
+    }
+    factors.push_back(fromWord(acc));
+    return productOf(std::move(factors), threads);
 }
 
-bool operator<(const BigInteger& bnum1, const BigInteger& bnum2) {
-    if (bnum1.numLength() == 0) {
-        if (bnum2.numLength() == 0) {
-            return false;
-        }
-        return bnum2.numSign() == 1;
+BigInteger BigInteger::oddFactorial(uint64_t num,
+                                    const std::vector<uint64_t>& primes,
+                                    size_t threads) {
+    if (num < 3) {
+        return 1;
     }
-    if (bnum2.numLength() == 0) {
-        return bnum1.numSign() != 1;
+    BigInteger half = oddFactorial(num / 2, primes, threads);
+    std::vector<DoubleLimb> powers;
+    for (size_t i = 1; i < primes.size() && primes[i] <= num; ++i) {
+        DoubleLimb power = 1;
+        for (uint64_t rest = num / primes[i]; rest > 0; rest /= primes[i]) {
+            if (rest % 2 != 0) {
+                power *= primes[i];
+            }
+        }
+        if (power > 1) {
+            powers.push_back(power);
+        }
     }
-    if (bnum1.numSign() != bnum2.numSign()) {
-        return bnum1.numSign() < bnum2.numSign();
+    return multiply(multiply(half, half, threads),
+                    productOfWords(powers, threads), threads);
+}
+
+BigInteger productOf(std::vector<BigInteger> factors, size_t threads) {
+    if (factors.empty()) {
+        return 1;
     }
-    if (bnum1.numSign() == 1) {
-        if (bnum1.numLength() != bnum2.numLength()) {
-            return bnum1.numLength() < bnum2.numLength();
+    while (factors.size() > 1) {
+        size_t pairs = factors.size() / 2, limbs = 0;
+        for (const BigInteger& factor : factors) {
+            limbs += factor.limbCount();
         }
-        for (int i = static_cast<int>(bnum1.numLength()) - 1; i >= 0; --i) {
-            if (bnum1[i] != bnum2[i]) {
-                return bnum1[i] < bnum2[i];
+        std::vector<BigInteger> next(pairs + factors.size() % 2);
+        auto mul_pairs = [&](size_t from, size_t to, size_t mul_threads) {
+            for (size_t i = from; i < to; ++i) {
+                next[i] =
+                    multiply(factors[2 * i], factors[2 * i + 1], mul_threads);
+            }
+        };
+        if (threads <= 1 || limbs < BigInteger::kParallelThreshold) {
+            mul_pairs(0, pairs, 1);
+        } else {
+            size_t workers_count = std::min(threads, pairs);
+            size_t step = (pairs + workers_count - 1) / workers_count;
+            size_t mul_threads = threads / workers_count;
+            std::vector<std::thread> workers;
+            for (size_t from = step; from < pairs; from += step) {
+                workers.emplace_back(mul_pairs, from,
+                                     std::min(from + step, pairs),
+                                     mul_threads);
+            }
+            mul_pairs(0, step, mul_threads);
+            for (std::thread& worker : workers) {
+                worker.join();
             }
         }
-        return false;
+        if (factors.size() % 2 != 0) {
+            next.back() = std::move(factors.back());
+        }
+        factors = std::move(next);
     }
-    if (bnum1.numLength() != bnum2.numLength()) {
-        return bnum1.numLength() > bnum2.numLength();
+    return std::move(factors[0]);
+}
+
+BigInteger factorial(uint64_t num, size_t threads) {
+    BigInteger res = BigInteger::oddFactorial(
+        num, BigInteger::primesUpTo(num), threads);
+    res <<= num - std::popcount(num);
+    return res;
+}
+
+BigInteger binomial(uint64_t num, uint64_t choose, size_t threads) {
+    if (choose > num) {
+        return 0;
     }
-    for (int i = static_cast<int>(bnum1.numLength()) - 1; i >= 0; --i) {
-        if (bnum1[i] != bnum2[i]) {
-            return bnum1[i] > bnum2[i];
+    choose = std::min(choose, num - choose);
+    if (choose < num / BigInteger::kBinomialSieveRatio) {
+        std::vector<BigInteger::DoubleLimb> words;
+        for (uint64_t i = num - choose + 1; i <= num; ++i) {
+            words.push_back(i);
+        }
+        return BigInteger::productOfWords(words, threads) /
+               factorial(choose, threads);
+    }
+    std::vector<BigInteger::DoubleLimb> powers;
+    for (uint64_t prime : BigInteger::primesUpTo(num)) {
+        BigInteger::DoubleLimb power = 1;
+        uint64_t num_rest = num, choose_rest = choose, other_rest = num - choose;
+        while ((num_rest /= prime) > 0) {
+            choose_rest /= prime;
+            other_rest /= prime;
+            if (num_rest != choose_rest + other_rest) {
+                power *= prime;
+            }
+        }
+        if (power > 1) {
+            powers.push_back(power);
         }
     }
-    return false;
+    return BigInteger::productOfWords(powers, threads);
 }
 
-bool operator>=(const BigInteger& bnum1, const BigInteger& bnum2) {
-    return !(bnum1 < bnum2);
+BigInteger powmod(const BigInteger& base, const BigInteger& exp,
+                  const BigInteger& mod) {
+    if (!mod || (exp.isNegative && exp)) {
+        throw std::domain_error("");
+    }
+    BigInteger modulus = mod;
+    modulus.isNegative = false;
+    if (modulus.digits[0] % 2 == 1) {
+        return MontgomeryContext(modulus).pow(base, exp);
+    }
+    BigInteger recip;
+    if (modulus.limbCount() > 1) {
+        recip = BigInteger::reciprocal(modulus);
+    }
+    auto mul = [&modulus, &recip](const BigInteger& bnum1,
+                                  const BigInteger& bnum2) {
+        BigInteger product = multiply(bnum1, bnum2, 1), quotient, remainder;
+        if (recip) {
+            BigInteger::divModNewton(product, modulus, recip, quotient,
+                                     remainder);
+        } else {
+            BigInteger::divModAbs(product, modulus, quotient, remainder);
+        }
+        return remainder;
+    };
+    return BigInteger::powWindow(BigInteger::reduceMod(base, modulus), exp, 1,
+                                 mul);
 }
 
-bool operator>(const BigInteger& bnum1, const BigInteger& bnum2) {
-    return bnum2 < bnum1;
+MontgomeryContext::MontgomeryContext(const BigInteger& mod) : modulus(mod) {
+    if (!mod || mod.digits[0] % 2 == 0) {
+        throw std::domain_error("");
+    }
+    modulus.isNegative = false;
+    size_t len = modulus.limbCount();
+    uint32_t inverse = modulus.digits[0];
+    for (int i = 0; i < 4; ++i) {
+        inverse *= 2 - modulus.digits[0] * inverse;
+    }
+    wordInverse = -inverse;
+    rSquared = 1;
+    rSquared.shiftLimbs(2 * len);
+    rSquared = BigInteger::reduceMod(rSquared, modulus);
+    if (len < BigInteger::kKaratsubaThreshold) {
+        return;
+    }
+    BigInteger full_inverse = BigInteger::fromWord(inverse);
+    for (size_t prec = 1; prec < len;) {
+        prec = std::min(2 * prec, len);
+        BigInteger error = modulus.limbSlice(0, prec) * full_inverse - 1;
+        error = error.limbSlice(0, prec);
+        BigInteger correction = (full_inverse * error).limbSlice(0, prec);
+        full_inverse.digits.resize(prec + 1);
+        full_inverse.digits[prec] = 1;
+        full_inverse -= correction;
+        full_inverse = full_inverse.limbSlice(0, prec);
+    }
+    negInverse = 1;
+    negInverse.shiftLimbs(len);
+    negInverse -= full_inverse;
 }
 
-bool operator<=(const BigInteger& bnum1, const BigInteger& bnum2) {
-    return !(bnum2 < bnum1);
+BigInteger MontgomeryContext::reduce(BigInteger bnum) const {
+    using Limb = BigInteger::Limb;
+    using DoubleLimb = BigInteger::DoubleLimb;
+    size_t len = modulus.limbCount();
+    if (len >= BigInteger::kKaratsubaThreshold) {
+        BigInteger quotient =
+            (bnum.limbSlice(0, len) * negInverse).limbSlice(0, len);
+        bnum.addmul(quotient, modulus);
+        bnum = bnum.limbSlice(len, len + 1);
+    } else {
+        bnum.digits.resize(2 * len + 1);
+        Limb* limbs = bnum.digits.data();
+        const Limb* mod_limbs = modulus.digits.data();
+        for (size_t i = 0; i < len; ++i) {
+            Limb quotient = limbs[i] * wordInverse;
+            DoubleLimb transf = 0;
+            for (size_t j = 0; j < len; ++j) {
+                transf += limbs[i + j] +
+                          static_cast<DoubleLimb>(quotient) * mod_limbs[j];
+                limbs[i + j] = transf % BigInteger::kNumSys;
+                transf /= BigInteger::kNumSys;
+            }
+            for (size_t j = i + len; transf != 0; ++j) {
+                transf += limbs[j];
+                limbs[j] = transf % BigInteger::kNumSys;
+                transf /= BigInteger::kNumSys;
+            }
+        }
+        std::copy(limbs + len, limbs + 2 * len + 1, limbs);
+        bnum.digits.resize(len + 1);
+        bnum.removeLeadingZeros();
+    }
+    if (bnum >= modulus) {
+        bnum -= modulus;
+    }
+    return bnum;
 }
 
-BigInteger operator+(BigInteger bnum1, const BigInteger& bnum2) {
-    return bnum1 += bnum2;
+BigInteger MontgomeryContext::toMontgomery(const BigInteger& bnum) const {
+    return reduce(
+        ::multiply(BigInteger::reduceMod(bnum, modulus), rSquared, 1));
 }
 
-BigInteger operator-(BigInteger bnum1, const BigInteger& bnum2) {
-    return bnum1 -= bnum2;
+BigInteger MontgomeryContext::fromMontgomery(const BigInteger& bnum) const {
+    return reduce(bnum);
 }
 
-BigInteger operator*(BigInteger bnum1, const BigInteger& bnum2) {
-    return bnum1 *= bnum2;
+BigInteger MontgomeryContext::multiply(const BigInteger& bnum1,
+                                       const BigInteger& bnum2) const {
+    return reduce(::multiply(bnum1, bnum2, 1));
 }
 
-BigInteger& BigInteger::operator/=(BigInteger bnum) {
-    if (bnum.isNegative) {
-        isNegative = !isNegative;
-        bnum.isNegative = false;
-    }
-    BigInteger res, suff;
-    for (int i = static_cast<int>(digits.size()) - 1; i >= 0; --i) {
-        suff.siftLeft();
-        suff += digits[i];
-        res.siftLeft();
-        int left = 0, right = kNumSys;
-        while (right - left > 1) {
-            int middle = (left + right) / 2;
-            if (bnum * middle <= suff) {
-                left = middle;
-            } else {
-                right = middle;
-            }
-        }
-        suff -= bnum * left;
-        res += left;
+BigInteger MontgomeryContext::pow(const BigInteger& base,
+                                  const BigInteger& exp) const {
+    if (exp.isNegative && exp) {
+        throw std::domain_error("");
     }
-    std::swap(digits, res.digits);
-    return *this;
+    return fromMontgomery(BigInteger::powWindow(
+        toMontgomery(base), exp, toMontgomery(1),
+        [this](const BigInteger& bnum1, const BigInteger& bnum2) {
+            return multiply(bnum1, bnum2);
+        }));
 }
 
-BigInteger& BigInteger::operator%=(BigInteger bnum) {
-    if (bnum.isNegative) {
-        isNegative = !isNegative;
-        bnum.isNegative = false;
-    }
-    BigInteger res;
-    for (int i = static_cast<int>(digits.size()) - 1; i >= 0; --i) {
-        res.siftLeft();
-        res += digits[i];
-        int left = 0, right = kNumSys;
-        while (right - left > 1) {
-            int middle = (left + right) / 2;
-            if (bnum * middle <= res) {
-                left = middle;
-            } else {
-                right = middle;
-            }
-        }
-        res -= bnum * left;
-    }
-    std::swap(digits, res.digits);
-    return *this;
+BigIntegerMemoryScope::BigIntegerMemoryScope(
+    std::pmr::memory_resource* resource)
+    : previous(BigInteger::threadResource) {
+    BigInteger::threadResource = BigInteger::heapOrResource(resource);
 }
 
-BigInteger operator/(BigInteger bnum1, const BigInteger& bnum2) {
-    return bnum1 /= bnum2;
+BigIntegerMemoryScope::~BigIntegerMemoryScope() {
+    BigInteger::threadResource = previous;
 }
 
-BigInteger operator%(BigInteger bnum1, const BigInteger& bnum2) {
-    return bnum1 %= bnum2;
-}
+BigIntegerArena::BigIntegerArena() : pool(), scope(&pool) {}
 
-BigInteger Rational::gcd(BigInteger bnum1, BigInteger bnum2) {
-    if (bnum2 == 0) {
-        return bnum1;
-    }
-    return gcd(bnum2, bnum1 % bnum2);
+BigIntegerArena::BigIntegerArena(std::pmr::memory_resource* upstream)
+    : pool(upstream), scope(&pool) {}
+
+std::pmr::memory_resource* BigIntegerArena::resource() {
+    return &pool;
 }
 
 void Rational::reduceFraction() {
@@ -388,9 +2347,23 @@ void Rational::reduceFraction() {
     numerator /= div;
     denominator /= div;
     if (denominator.numSign() == -1) {
-        denominator *= -1;
-        numerator *= -1;
+        denominator.negate();
+        numerator.negate();
+    }
+}
+
+void Rational::addFraction(const BigInteger& num, const BigInteger& den) {
+    BigInteger div1 = gcd(denominator, den);
+    if (div1 == 1) {
+        numerator = numerator * den + num * denominator;
+        denominator *= den;
+        return;
     }
+    BigInteger den1 = denominator / div1;
+    BigInteger sum = numerator * (den / div1) + num * den1;
+    BigInteger div2 = gcd(sum, div1);
+    numerator = sum / div2;
+    denominator = den1 * (den / div2);
 }
 
 void Rational::swap(Rational& rnum) {
@@ -398,12 +2371,68 @@ void Rational::swap(Rational& rnum) {
     std::swap(denominator, rnum.denominator);
 }
 
+template <std::floating_point Float>
+Float Rational::toFloating() const {
+    const int64_t kDigits = std::numeric_limits<Float>::digits;
+    const int64_t kMinExponent = std::numeric_limits<Float>::min_exponent;
+    auto bit_length = [](const BigInteger& bnum) -> int64_t {
+        size_t len = bnum.limbCount();
+        return len == 0 ? 0 : 32 * len - std::countl_zero(bnum.limb(len - 1));
+    };
+    auto top_word = [](const BigInteger& bnum) {
+        unsigned __int128 res = 0;
+        for (size_t i = bnum.limbCount(); i-- > 0;) {
+            res = res << 32 | bnum.limb(i);
+        }
+        return res;
+    };
+    Float sign = numerator.numSign() < 0 && numerator ? -1 : 1;
+    int64_t num_bits = bit_length(numerator);
+    int64_t den_bits = bit_length(denominator);
+    if (num_bits <= kDigits && den_bits <= kDigits) {
+        return sign * static_cast<Float>(top_word(numerator)) /
+               static_cast<Float>(top_word(denominator));
+    }
+    int64_t shift = kDigits + 2 - (num_bits - den_bits);
+    BigInteger num = numerator, den = denominator;
+    if (num.numSign() < 0) {
+        num.negate();
+    }
+    if (shift > 0) {
+        num <<= shift;
+    } else {
+        den <<= -shift;
+    }
+    auto [quotient, remainder] = divmod(num, den);
+    int64_t quotient_bits = bit_length(quotient);
+    int64_t precision =
+        kDigits - std::max<int64_t>(0, kMinExponent - (quotient_bits - shift));
+    if (precision < 0) {
+        return sign * 0;
+    }
+    int64_t drop = quotient_bits - precision;
+    unsigned __int128 mantissa = top_word(quotient), one = 1;
+    unsigned __int128 kept = mantissa >> drop;
+    unsigned __int128 rest = mantissa & ((one << drop) - 1);
+    unsigned __int128 half = one << (drop - 1);
+    if (rest > half ||
+        (rest == half && (remainder || (kept & 1) != 0))) {
+        ++kept;
+    }
+    return sign * std::ldexp(static_cast<Float>(kept),
+                             static_cast<int>(drop - shift));
+}
+
 Rational::Rational() : numerator(0), denominator(1) {}
 
 Rational::Rational(int num) : numerator(num), denominator(1) {}
 
 Rational::Rational(BigInteger bnum) : numerator(bnum), denominator(1){};
 
+Rational::Rational(const Rational& rnum, std::pmr::memory_resource* resource)
+    : numerator(rnum.numerator, resource),
+      denominator(rnum.denominator, resource) {}
+
 BigInteger Rational::getNumerator() const {
     return numerator;
 }
@@ -414,35 +2443,41 @@ BigInteger Rational::getDenominator() const {
 
 Rational Rational::operator-() const {
     Rational copy(*this);
-    copy.numerator *= -1;
+    copy.numerator.negate();
     return copy;
 }
 
 Rational& Rational::operator+=(const Rational& rnum) {
-    numerator = numerator * rnum.denominator + rnum.numerator * denominator;
-    denominator *= rnum.denominator;
-    reduceFraction();
+    addFraction(rnum.numerator, rnum.denominator);
     return *this;
 }
 
 Rational& Rational::operator-=(const Rational& rnum) {
-    numerator = numerator * rnum.denominator - rnum.numerator * denominator;
-    denominator *= rnum.denominator;
-    reduceFraction();
+    addFraction(-rnum.numerator, rnum.denominator);
     return *this;
 }
 
 Rational& Rational::operator*=(const Rational& rnum) {
-    numerator *= rnum.numerator;
-    denominator *= rnum.denominator;
-    reduceFraction();
+    BigInteger div1 = gcd(numerator, rnum.denominator);
+    BigInteger div2 = gcd(rnum.numerator, denominator);
+    numerator = numerator / div1 * (rnum.numerator / div2);
+    denominator = denominator / div2 * (rnum.denominator / div1);
     return *this;
 }
 
 Rational& Rational::operator/=(const Rational& rnum) {
-    numerator *= rnum.denominator;
-    denominator *= rnum.numerator;
-    reduceFraction();
+    if (!rnum.numerator) {
+        throw std::domain_error("");
+    }
+    BigInteger div1 = gcd(numerator, rnum.numerator);
+    BigInteger div2 = gcd(rnum.denominator, denominator);
+    BigInteger new_denominator = denominator / div2 * (rnum.numerator / div1);
+    numerator = numerator / div1 * (rnum.denominator / div2);
+    denominator = new_denominator;
+    if (denominator.numSign() == -1) {
+        denominator.negate();
+        numerator.negate();
+    }
     return *this;
 }
 
@@ -456,54 +2491,83 @@ std::string Rational::toString() const {
 }
 
 std::string Rational::asDecimal(size_t precision) const {
+    std::string res(maxDecimalLength(precision), '\0');
+    res.resize(asDecimal(res.data(), precision) - res.data());
+    return res;
+}
+
+size_t Rational::maxDecimalLength(size_t precision) const {
+    return numerator.maxCharsLength() + precision + 2;
+}
+
+char* Rational::asDecimal(char* buf, size_t precision) const {
     BigInteger copy(numerator);
-    for (size_t i = 0; i < precision; ++i) {
-        copy *= 10;
-    }
+    copy *= pow(BigInteger(10), precision);
     copy /= denominator;
-    std::string res(copy.toString());
+    char* end = copy.toChars(buf);
     if (precision == 0) {
-        return res;
-    }
-    size_t len = res.size();
-    if (res.front() == '-') {
-        --len;
+        return end;
     }
+    char* start = *buf == '-' ? buf + 1 : buf;
+    size_t len = end - start;
     if (len <= precision) {
-        for (size_t i = 0; i <= precision - len; ++i) {
-            res.push_back('0');
-        }
-        size_t start = static_cast<size_t>(res.front() == '-');
-        for (size_t i = 0; i < len; ++i) {
-            std::swap(res[res.size() - i - 1], res[start + len - i - 1]);
-        }
+        size_t pad = precision + 1 - len;
+        std::memmove(start + pad, start, len);
+        std::fill(start, start + pad, '0');
+        end += pad;
     }
-    res.push_back('.');
-    for (int i = static_cast<int>(res.size()) - 1;
-         i >= static_cast<int>(res.size() - precision); --i) {
-        std::swap(res[i], res[i - 1]);
+    std::memmove(end - precision + 1, end - precision, precision);
+    *(end - precision) = '.';
+    return end + 1;
+}
+
+size_t Rational::serializedSize() const {
+    return numerator.serializedSize() + denominator.serializedSize();
+}
+
+size_t Rational::serialize(std::span<std::byte> buf) const {
+    size_t size = numerator.serialize(buf);
+    return size + denominator.serialize(buf.subspan(size));
+}
+
+size_t Rational::deserialize(std::span<const std::byte> buf) {
+    BigInteger num, den;
+    size_t size = num.deserialize(buf);
+    size += den.deserialize(buf.subspan(size));
+    if (den.numSign() < 0 || !den || gcd(num, den) != 1) {
+        throw std::invalid_argument("");
     }
-    return res;
+    numerator = std::move(num);
+    denominator = std::move(den);
+    return size;
 }
 
 Rational::operator double() const {
-    return std::stod((*this).asDecimal(18));
+    return toFloating<double>();
+}
+
+Rational::operator long double() const {
+    return toFloating<long double>();
 }
 
 Rational operator+(Rational rnum1, const Rational& rnum2) {
-    return rnum1 += rnum2;
+    rnum1 += rnum2;
+    return rnum1;
 }
 
 Rational operator-(Rational rnum1, const Rational& rnum2) {
-    return rnum1 -= rnum2;
+    rnum1 -= rnum2;
+    return rnum1;
 }
 
 Rational operator*(Rational rnum1, const Rational& rnum2) {
-    return rnum1 *= rnum2;
+    rnum1 *= rnum2;
+    return rnum1;
 }
 
 Rational operator/(Rational rnum1, const Rational& rnum2) {
-    return rnum1 /= rnum2;
+    rnum1 /= rnum2;
+    return rnum1;
 }
 
 bool operator==(const Rational& rnum1, const Rational& rnum2) {
@@ -531,3 +2595,229 @@ bool operator>(const Rational& rnum1, const Rational& rnum2) {
 bool operator<=(const Rational& rnum1, const Rational& rnum2) {
     return !(rnum2 < rnum1);
 }
+
+int RationalAccumulator::compare(const BigInteger& num1,
+                                 const BigInteger& den1,
+                                 const BigInteger& num2,
+                                 const BigInteger& den2) {
+    // Denominators are kept positive, so the signs of the numerators decide
+    // most comparisons without multiplying anything.
+    if (num1.numSign() != num2.numSign()) {
+        return num1.numSign() < num2.numSign() ? -1 : 1;
+    }
+    BigInteger lhs = num1 * den2;
+    BigInteger rhs = num2 * den1;
+    if (lhs == rhs) {
+        return 0;
+    }
+    return lhs < rhs ? -1 : 1;
+}
+
+int RationalAccumulator::compare(const RationalAccumulator& acc1,
+                                 const RationalAccumulator& acc2) {
+    return compare(acc1.numerator, acc1.denominator, acc2.numerator,
+                   acc2.denominator);
+}
+
+int RationalAccumulator::compare(const RationalAccumulator& acc,
+                                 const Rational& rnum) {
+    return compare(acc.numerator, acc.denominator, rnum.numerator,
+                   rnum.denominator);
+}
+
+void RationalAccumulator::reduceIfLarge() {
+    if (denominator.limbCount() <= std::max(kReduceThreshold,
+                                            2 * reducedLength)) {
+        return;
+    }
+    BigInteger div = gcd(numerator, denominator);
+    numerator /= div;
+    denominator /= div;
+    reducedLength = denominator.limbCount();
+}
+
+RationalAccumulator::RationalAccumulator()
+    : numerator(0), denominator(1), reducedLength(0) {}
+
+RationalAccumulator::RationalAccumulator(const Rational& rnum)
+    : numerator(rnum.numerator),
+      denominator(rnum.denominator),
+      reducedLength(rnum.denominator.limbCount()) {}
+
+RationalAccumulator& RationalAccumulator::operator+=(const Rational& rnum) {
+    numerator = numerator * rnum.denominator + rnum.numerator * denominator;
+    denominator *= rnum.denominator;
+    reduceIfLarge();
+    return *this;
+}
+
+RationalAccumulator& RationalAccumulator::operator-=(const Rational& rnum) {
+    numerator = numerator * rnum.denominator - rnum.numerator * denominator;
+    denominator *= rnum.denominator;
+    reduceIfLarge();
+    return *this;
+}
+
+RationalAccumulator& RationalAccumulator::operator*=(const Rational& rnum) {
+    numerator *= rnum.numerator;
+    denominator *= rnum.denominator;
+    reduceIfLarge();
+    return *this;
+}
+
+RationalAccumulator& RationalAccumulator::operator/=(const Rational& rnum) {
+    if (!rnum.numerator) {
+        throw std::domain_error("");
+    }
+    numerator *= rnum.denominator;
+    denominator *= rnum.numerator;
+    if (denominator.numSign() == -1) {
+        denominator.negate();
+        numerator.negate();
+    }
+    reduceIfLarge();
+    return *this;
+}
+
+Rational RationalAccumulator::normalize() const {
+    Rational res;
+    res.numerator = numerator;
+    res.denominator = denominator;
+    res.reduceFraction();
+    return res;
+}
+
+RationalAccumulator::operator Rational() const {
+    return normalize();
+}
+
+std::string RationalAccumulator::toString() const {
+    return normalize().toString();
+}
+
+std::string RationalAccumulator::asDecimal(size_t precision) const {
+    return normalize().asDecimal(precision);
+}
+
+RationalAccumulator::operator double() const {
+    return static_cast<double>(normalize());
+}
+
+RationalAccumulator::operator long double() const {
+    return static_cast<long double>(normalize());
+}
+
+bool operator==(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2) {
+    return RationalAccumulator::compare(acc1, acc2) == 0;
+}
+
+bool operator==(const RationalAccumulator& acc, const Rational& rnum) {
+    return RationalAccumulator::compare(acc, rnum) == 0;
+}
+
+bool operator==(const Rational& rnum, const RationalAccumulator& acc) {
+    return acc == rnum;
+}
+
+bool operator!=(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2) {
+    return !(acc1 == acc2);
+}
+
+bool operator!=(const RationalAccumulator& acc, const Rational& rnum) {
+    return !(acc == rnum);
+}
+
+bool operator!=(const Rational& rnum, const RationalAccumulator& acc) {
+    return !(rnum == acc);
+}
+
+bool operator<(const RationalAccumulator& acc1,
+               const RationalAccumulator& acc2) {
+    return RationalAccumulator::compare(acc1, acc2) < 0;
+}
+
+bool operator<(const RationalAccumulator& acc, const Rational& rnum) {
+    return RationalAccumulator::compare(acc, rnum) < 0;
+}
+
+bool operator<(const Rational& rnum, const RationalAccumulator& acc) {
+    return RationalAccumulator::compare(acc, rnum) > 0;
+}
+
+bool operator>=(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2) {
+    return !(acc1 < acc2);
+}
+
+bool operator>=(const RationalAccumulator& acc, const Rational& rnum) {
+    return !(acc < rnum);
+}
+
+bool operator>=(const Rational& rnum, const RationalAccumulator& acc) {
+    return !(rnum < acc);
+}
+
+bool operator>(const RationalAccumulator& acc1,
+               const RationalAccumulator& acc2) {
+    return acc2 < acc1;
+}
+
+bool operator>(const RationalAccumulator& acc, const Rational& rnum) {
+    return rnum < acc;
+}
+
+bool operator>(const Rational& rnum, const RationalAccumulator& acc) {
+    return acc < rnum;
+}
+
+bool operator<=(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2) {
+    return !(acc2 < acc1);
+}
+
+bool operator<=(const RationalAccumulator& acc, const Rational& rnum) {
+    return !(rnum < acc);
+}
+
+bool operator<=(const Rational& rnum, const RationalAccumulator& acc) {
+    return !(acc < rnum);
+}
+
+BigIntegerWriter::BigIntegerWriter(std::ostream& stream) : out(stream) {}
+
+BigIntegerWriter& BigIntegerWriter::operator<<(const BigInteger& bnum) {
+    buffer.resize(std::max(buffer.size(), bnum.serializedSize()));
+    size_t size = bnum.serialize(buffer);
+    out.write(reinterpret_cast<const char*>(buffer.data()), size);
+    return *this;
+}
+
+BigIntegerWriter& BigIntegerWriter::operator<<(const Rational& rnum) {
+    buffer.resize(std::max(buffer.size(), rnum.serializedSize()));
+    size_t size = rnum.serialize(buffer);
+    out.write(reinterpret_cast<const char*>(buffer.data()), size);
+    return *this;
+}
+
+BigIntegerReader::BigIntegerReader(std::span<const std::byte> buf)
+    : data(buf), pos(0) {}
+
+bool BigIntegerReader::atEnd() const {
+    return pos == data.size();
+}
+
+size_t BigIntegerReader::position() const {
+    return pos;
+}
+
+BigIntegerReader& BigIntegerReader::operator>>(BigInteger& bnum) {
+    pos += bnum.deserialize(data.subspan(pos));
+    return *this;
+}
+
+BigIntegerReader& BigIntegerReader::operator>>(Rational& rnum) {
+    pos += rnum.deserialize(data.subspan(pos));
+    return *this;
+}
@@ -1,37 +1,1174 @@
-#include <deque>
+#if __cplusplus < 202002L
+#error "biginteger.h requires C++20"
+#endif
+
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class BigInteger;
+
+template <size_t kBits>
+class FixedBigInteger {
+  private:
+    static constexpr size_t kLimbs = (kBits + 31) / 32;
+    bool isNegative = false;
+    size_t length = 0;
+    uint32_t digits[kLimbs] = {};
+
+    friend class BigInteger;
+
+    constexpr void removeLeadingZeros() {
+        while (length > 0 && digits[length - 1] == 0) {
+            --length;
+        }
+        if (length == 0) {
+            isNegative = false;
+        }
+    }
+
+    constexpr void checkOverflow() const {
+        if (kBits % 32 != 0 && digits[kLimbs - 1] >> (kBits % 32) != 0) {
+            throw std::overflow_error("");
+        }
+    }
+
+    constexpr void mulAddLimb(uint32_t mul, uint32_t add) {
+        uint64_t transf = add;
+        for (size_t i = 0; i < length; ++i) {
+            transf += static_cast<uint64_t>(digits[i]) * mul;
+            digits[i] = static_cast<uint32_t>(transf);
+            transf >>= 32;
+        }
+        if (transf != 0) {
+            if (length == kLimbs) {
+                throw std::overflow_error("");
+            }
+            digits[length++] = static_cast<uint32_t>(transf);
+        }
+        checkOverflow();
+    }
+
+    constexpr uint32_t divideByLimb(uint32_t divisor) {
+        uint64_t rem = 0;
+        for (size_t i = length; i-- > 0;) {
+            rem = rem << 32 | digits[i];
+            digits[i] = static_cast<uint32_t>(rem / divisor);
+            rem %= divisor;
+        }
+        removeLeadingZeros();
+        return static_cast<uint32_t>(rem);
+    }
+
+    static constexpr int compareAbs(const FixedBigInteger& fnum1,
+                                    const FixedBigInteger& fnum2) {
+        if (fnum1.length != fnum2.length) {
+            return fnum1.length < fnum2.length ? -1 : 1;
+        }
+        for (size_t i = fnum1.length; i-- > 0;) {
+            if (fnum1.digits[i] != fnum2.digits[i]) {
+                return fnum1.digits[i] < fnum2.digits[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    constexpr void addSigned(const FixedBigInteger& fnum, bool negative) {
+        if (isNegative == negative || length == 0) {
+            isNegative = negative;
+            uint64_t transf = 0;
+            length = std::max(length, fnum.length);
+            for (size_t i = 0; i < length; ++i) {
+                transf += static_cast<uint64_t>(digits[i]) + fnum.digits[i];
+                digits[i] = static_cast<uint32_t>(transf);
+                transf >>= 32;
+            }
+            if (transf != 0) {
+                if (length == kLimbs) {
+                    throw std::overflow_error("");
+                }
+                digits[length++] = 1;
+            }
+            checkOverflow();
+            return;
+        }
+        FixedBigInteger larger = fnum, smaller = *this;
+        larger.isNegative = negative;
+        if (compareAbs(*this, fnum) >= 0) {
+            std::swap(larger, smaller);
+        }
+        int64_t borrow = 0;
+        for (size_t i = 0; i < larger.length; ++i) {
+            int64_t now = static_cast<int64_t>(larger.digits[i]) - borrow -
+                          smaller.digits[i];
+            borrow = now < 0 ? 1 : 0;
+            larger.digits[i] = static_cast<uint32_t>(now);
+        }
+        larger.removeLeadingZeros();
+        *this = larger;
+    }
+
+    static constexpr void divModAbs(const FixedBigInteger& fnum1,
+                                    const FixedBigInteger& fnum2,
+                                    FixedBigInteger& quotient,
+                                    FixedBigInteger& remainder) {
+        if (fnum2.length == 0) {
+            throw std::domain_error("");
+        }
+        quotient = FixedBigInteger();
+        remainder = fnum1;
+        remainder.isNegative = false;
+        if (compareAbs(fnum1, fnum2) < 0) {
+            return;
+        }
+        if (fnum2.length == 1) {
+            quotient = remainder;
+            remainder = quotient.divideByLimb(fnum2.digits[0]);
+            return;
+        }
+        size_t len1 = fnum1.length, len2 = fnum2.length;
+        int shift = std::countl_zero(fnum2.digits[len2 - 1]);
+        uint32_t num[kLimbs + 1] = {}, div[kLimbs] = {};
+        for (size_t i = len2; i-- > 0;) {
+            div[i] = fnum2.digits[i] << shift;
+            if (shift != 0 && i > 0) {
+                div[i] |= fnum2.digits[i - 1] >> (32 - shift);
+            }
+        }
+        for (size_t i = len1 + 1; i-- > 0;) {
+            num[i] = i < len1 ? fnum1.digits[i] << shift : 0;
+            if (shift != 0 && i > 0) {
+                num[i] |= fnum1.digits[i - 1] >> (32 - shift);
+            }
+        }
+        for (size_t j = len1 - len2 + 1; j-- > 0;) {
+            uint64_t now_num =
+                static_cast<uint64_t>(num[j + len2]) << 32 | num[j + len2 - 1];
+            uint64_t guess = now_num / div[len2 - 1];
+            uint64_t rest = now_num % div[len2 - 1];
+            while (guess >> 32 != 0 ||
+                   guess * div[len2 - 2] > (rest << 32 | num[j + len2 - 2])) {
+                --guess;
+                rest += div[len2 - 1];
+                if (rest >> 32 != 0) {
+                    break;
+                }
+            }
+            uint64_t mul_transf = 0;
+            int64_t borrow = 0;
+            for (size_t i = 0; i < len2; ++i) {
+                mul_transf += guess * div[i];
+                int64_t now = static_cast<int64_t>(num[i + j]) - borrow -
+                              static_cast<int64_t>(mul_transf & 0xFFFFFFFF);
+                mul_transf >>= 32;
+                borrow = now < 0 ? 1 : 0;
+                num[i + j] = static_cast<uint32_t>(now);
+            }
+            int64_t top = static_cast<int64_t>(num[j + len2]) - borrow -
+                          static_cast<int64_t>(mul_transf);
+            num[j + len2] = static_cast<uint32_t>(top);
+            if (top < 0) {
+                --guess;
+                uint64_t transf = 0;
+                for (size_t i = 0; i < len2; ++i) {
+                    transf += static_cast<uint64_t>(num[i + j]) + div[i];
+                    num[i + j] = static_cast<uint32_t>(transf);
+                    transf >>= 32;
+                }
+                num[j + len2] += static_cast<uint32_t>(transf);
+            }
+            quotient.digits[j] = static_cast<uint32_t>(guess);
+        }
+        quotient.length = len1 - len2 + 1;
+        quotient.removeLeadingZeros();
+        for (size_t i = 0; i < kLimbs; ++i) {
+            remainder.digits[i] = i < len2 ? num[i] >> shift : 0;
+            if (shift != 0 && i < len2) {
+                remainder.digits[i] |= num[i + 1] << (32 - shift);
+            }
+        }
+        remainder.length = len2;
+        remainder.removeLeadingZeros();
+    }
+
+  public:
+    constexpr FixedBigInteger() = default;
+
+    constexpr FixedBigInteger(long long num) : isNegative(num < 0) {
+        unsigned long long abs_num =
+            num < 0 ? -static_cast<unsigned long long>(num) : num;
+        for (; abs_num != 0; abs_num >>= 32) {
+            if (length == kLimbs) {
+                throw std::overflow_error("");
+            }
+            digits[length++] = static_cast<uint32_t>(abs_num);
+        }
+        checkOverflow();
+    }
+
+    explicit FixedBigInteger(const BigInteger& bnum);
+
+    static constexpr FixedBigInteger fromChars(std::string_view str) {
+        FixedBigInteger res;
+        bool negative = !str.empty() && str.front() == '-';
+        for (size_t i = negative ? 1 : 0; i < str.size(); ++i) {
+            if (str[i] < '0' || str[i] > '9') {
+                throw std::invalid_argument("");
+            }
+            res.mulAddLimb(10, str[i] - '0');
+        }
+        res.isNegative = negative && res.length > 0;
+        return res;
+    }
+
+    static constexpr FixedBigInteger fromLiteral(std::string_view str) {
+        uint32_t base = 10;
+        if (str.size() > 1 && str[0] == '0') {
+            if (str[1] == 'x' || str[1] == 'X') {
+                base = 16;
+                str.remove_prefix(2);
+            } else if (str[1] == 'b' || str[1] == 'B') {
+                base = 2;
+                str.remove_prefix(2);
+            } else {
+                base = 8;
+            }
+        }
+        FixedBigInteger res;
+        for (char chr : str) {
+            uint32_t digit = base;
+            if (chr >= '0' && chr <= '9') {
+                digit = chr - '0';
+            } else if (chr >= 'a' && chr <= 'f') {
+                digit = chr - 'a' + 10;
+            } else if (chr >= 'A' && chr <= 'F') {
+                digit = chr - 'A' + 10;
+            } else if (chr == '\'') {
+                continue;
+            }
+            if (digit >= base) {
+                throw std::invalid_argument("");
+            }
+            res.mulAddLimb(base, digit);
+        }
+        return res;
+    }
+
+    constexpr explicit operator bool() const {
+        return length != 0;
+    }
+
+    constexpr uint32_t limb(size_t pos) const {
+        return digits[pos];
+    }
+
+    constexpr size_t limbCount() const {
+        return length;
+    }
+
+    constexpr int numSign() const {
+        return isNegative ? -1 : 1;
+    }
+
+    constexpr FixedBigInteger operator-() const {
+        FixedBigInteger copy(*this);
+        copy.isNegative = !copy.isNegative && copy.length != 0;
+        return copy;
+    }
+
+    constexpr FixedBigInteger& operator+=(const FixedBigInteger& fnum) {
+        addSigned(fnum, fnum.isNegative);
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator-=(const FixedBigInteger& fnum) {
+        addSigned(fnum, !fnum.isNegative && fnum.length != 0);
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator*=(const FixedBigInteger& fnum) {
+        uint32_t res[2 * kLimbs] = {};
+        for (size_t i = 0; i < fnum.length; ++i) {
+            uint64_t transf = 0;
+            for (size_t j = 0; j < length; ++j) {
+                transf += res[i + j] +
+                          static_cast<uint64_t>(digits[j]) * fnum.digits[i];
+                res[i + j] = static_cast<uint32_t>(transf);
+                transf >>= 32;
+            }
+            res[i + length] = static_cast<uint32_t>(transf);
+        }
+        size_t res_len = length + fnum.length;
+        while (res_len > 0 && res[res_len - 1] == 0) {
+            --res_len;
+        }
+        if (res_len > kLimbs) {
+            throw std::overflow_error("");
+        }
+        for (size_t i = 0; i < kLimbs; ++i) {
+            digits[i] = res[i];
+        }
+        length = res_len;
+        checkOverflow();
+        isNegative = isNegative != fnum.isNegative && length != 0;
+        return *this;
+    }
+
+    constexpr FixedBigInteger& operator/=(const FixedBigInteger& fnum) {
+        FixedBigInteger quotient, remainder;
+        divModAbs(*this, fnum, quotient, remainder);
+        quotient.isNegative =
+            isNegative != fnum.isNegative && quotient.length != 0;
+        return *this = quotient;
+    }
+
+    constexpr FixedBigInteger& operator%=(const FixedBigInteger& fnum) {
+        FixedBigInteger quotient, remainder;
+        divModAbs(*this, fnum, quotient, remainder);
+        remainder.isNegative =
+            isNegative != fnum.isNegative && remainder.length != 0;
+        return *this = remainder;
+    }
+
+    friend constexpr FixedBigInteger operator+(FixedBigInteger fnum1,
+                                               const FixedBigInteger& fnum2) {
+        fnum1 += fnum2;
+        return fnum1;
+    }
+
+    friend constexpr FixedBigInteger operator-(FixedBigInteger fnum1,
+                                               const FixedBigInteger& fnum2) {
+        fnum1 -= fnum2;
+        return fnum1;
+    }
+
+    friend constexpr FixedBigInteger operator*(FixedBigInteger fnum1,
+                                               const FixedBigInteger& fnum2) {
+        fnum1 *= fnum2;
+        return fnum1;
+    }
+
+    friend constexpr FixedBigInteger operator/(FixedBigInteger fnum1,
+                                               const FixedBigInteger& fnum2) {
+        fnum1 /= fnum2;
+        return fnum1;
+    }
+
+    friend constexpr FixedBigInteger operator%(FixedBigInteger fnum1,
+                                               const FixedBigInteger& fnum2) {
+        fnum1 %= fnum2;
+        return fnum1;
+    }
+
+    friend constexpr bool operator==(const FixedBigInteger& fnum1,
+                                     const FixedBigInteger& fnum2) {
+        return fnum1.isNegative == fnum2.isNegative &&
+               compareAbs(fnum1, fnum2) == 0;
+    }
+
+    friend constexpr bool operator!=(const FixedBigInteger& fnum1,
+                                     const FixedBigInteger& fnum2) {
+        return !(fnum1 == fnum2);
+    }
+
+    friend constexpr bool operator<(const FixedBigInteger& fnum1,
+                                    const FixedBigInteger& fnum2) {
+        if (fnum1.isNegative != fnum2.isNegative) {
+            return fnum1.isNegative;
+        }
+        int res = compareAbs(fnum1, fnum2);
+        return fnum1.isNegative ? res > 0 : res < 0;
+    }
+
+    friend constexpr bool operator>=(const FixedBigInteger& fnum1,
+                                     const FixedBigInteger& fnum2) {
+        return !(fnum1 < fnum2);
+    }
+
+    friend constexpr bool operator>(const FixedBigInteger& fnum1,
+                                    const FixedBigInteger& fnum2) {
+        return fnum2 < fnum1;
+    }
+
+    friend constexpr bool operator<=(const FixedBigInteger& fnum1,
+                                     const FixedBigInteger& fnum2) {
+        return !(fnum2 < fnum1);
+    }
+};
+
+template <size_t kLength>
+struct BigIntegerLiteral {
+    char chars[kLength];
+
+    constexpr BigIntegerLiteral(const char (&str)[kLength]) {
+        std::copy(str, str + kLength, chars);
+    }
+};
+
+template <size_t kBits>
+class WideInt {
+  private:
+    static_assert(kBits % 64 == 0 && kBits > 0);
+
+    using DoubleWord = unsigned __int128;
+
+    static constexpr size_t kWords = kBits / 64;
+    uint64_t words[kWords] = {};
+
+    template <size_t kOtherBits>
+    friend class WideInt;
+
+    friend class BigInteger;
+
+    constexpr bool isNegative() const {
+        return words[kWords - 1] >> 63 != 0;
+    }
+
+    constexpr size_t wordLength() const {
+        size_t len = kWords;
+        while (len > 0 && words[len - 1] == 0) {
+            --len;
+        }
+        return len;
+    }
+
+    constexpr WideInt magnitude() const {
+        return isNegative() ? -*this : *this;
+    }
+
+    static constexpr int compareUnsigned(const WideInt& wnum1,
+                                         const WideInt& wnum2) {
+        for (size_t i = kWords; i-- > 0;) {
+            if (wnum1.words[i] != wnum2.words[i]) {
+                return wnum1.words[i] < wnum2.words[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    static constexpr void divModAbs(const WideInt& wnum1,
+                                    const WideInt& wnum2, WideInt& quotient,
+                                    WideInt& remainder) {
+        size_t len1 = wnum1.wordLength(), len2 = wnum2.wordLength();
+        if (len2 == 0) {
+            throw std::domain_error("");
+        }
+        quotient = WideInt();
+        remainder = wnum1;
+        if (compareUnsigned(wnum1, wnum2) < 0) {
+            return;
+        }
+        if (len2 == 1) {
+            DoubleWord rem = 0;
+            for (size_t i = len1; i-- > 0;) {
+                rem = rem << 64 | wnum1.words[i];
+                quotient.words[i] = static_cast<uint64_t>(rem / wnum2.words[0]);
+                rem %= wnum2.words[0];
+            }
+            remainder = WideInt(static_cast<uint64_t>(rem));
+            return;
+        }
+        int shift = std::countl_zero(wnum2.words[len2 - 1]);
+        uint64_t num[kWords + 1] = {}, div[kWords] = {};
+        for (size_t i = len2; i-- > 0;) {
+            div[i] = wnum2.words[i] << shift;
+            if (shift != 0 && i > 0) {
+                div[i] |= wnum2.words[i - 1] >> (64 - shift);
+            }
+        }
+        for (size_t i = len1 + 1; i-- > 0;) {
+            num[i] = i < len1 ? wnum1.words[i] << shift : 0;
+            if (shift != 0 && i > 0) {
+                num[i] |= wnum1.words[i - 1] >> (64 - shift);
+            }
+        }
+        for (size_t j = len1 - len2 + 1; j-- > 0;) {
+            DoubleWord now_num =
+                static_cast<DoubleWord>(num[j + len2]) << 64 | num[j + len2 - 1];
+            DoubleWord guess = now_num / div[len2 - 1];
+            DoubleWord rest = now_num % div[len2 - 1];
+            while (guess >> 64 != 0 ||
+                   guess * div[len2 - 2] > (rest << 64 | num[j + len2 - 2])) {
+                --guess;
+                rest += div[len2 - 1];
+                if (rest >> 64 != 0) {
+                    break;
+                }
+            }
+            DoubleWord mul_transf = 0;
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < len2; ++i) {
+                mul_transf += guess * div[i];
+                uint64_t sub = static_cast<uint64_t>(mul_transf);
+                mul_transf >>= 64;
+                uint64_t now = num[i + j] - sub - borrow;
+                borrow = num[i + j] < sub ||
+                                 (num[i + j] == sub && borrow != 0)
+                             ? 1
+                             : 0;
+                num[i + j] = now;
+            }
+            bool below = num[j + len2] < mul_transf + borrow;
+            num[j + len2] -= static_cast<uint64_t>(mul_transf) + borrow;
+            if (below) {
+                --guess;
+                DoubleWord transf = 0;
+                for (size_t i = 0; i < len2; ++i) {
+                    transf += static_cast<DoubleWord>(num[i + j]) + div[i];
+                    num[i + j] = static_cast<uint64_t>(transf);
+                    transf >>= 64;
+                }
+                num[j + len2] += static_cast<uint64_t>(transf);
+            }
+            quotient.words[j] = static_cast<uint64_t>(guess);
+        }
+        for (size_t i = 0; i < kWords; ++i) {
+            remainder.words[i] = i < len2 ? num[i] >> shift : 0;
+            if (shift != 0 && i < len2) {
+                remainder.words[i] |= num[i + 1] << (64 - shift);
+            }
+        }
+    }
+
+  public:
+    constexpr WideInt() = default;
+
+    template <std::integral T>
+    constexpr WideInt(T num) {
+        uint64_t fill = std::cmp_less(num, 0) ? ~uint64_t(0) : 0;
+        words[0] = static_cast<uint64_t>(num);
+        for (size_t i = 1; i < kWords; ++i) {
+            words[i] = fill;
+        }
+    }
+
+    template <size_t kOtherBits>
+    constexpr explicit WideInt(const WideInt<kOtherBits>& wnum) {
+        uint64_t fill = wnum.isNegative() ? ~uint64_t(0) : 0;
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = i < WideInt<kOtherBits>::kWords ? wnum.words[i] : fill;
+        }
+    }
+
+    explicit WideInt(const BigInteger& bnum);
+
+    constexpr explicit operator bool() const {
+        return wordLength() != 0;
+    }
+
+    constexpr int numSign() const {
+        return isNegative() ? -1 : 1;
+    }
+
+    std::string toString() const;
+
+    constexpr WideInt operator-() const {
+        WideInt res = ~*this;
+        return ++res;
+    }
+
+    constexpr WideInt operator~() const {
+        WideInt res;
+        for (size_t i = 0; i < kWords; ++i) {
+            res.words[i] = ~words[i];
+        }
+        return res;
+    }
+
+    constexpr WideInt& operator++() {
+        for (size_t i = 0; i < kWords; ++i) {
+            if (++words[i] != 0) {
+                break;
+            }
+        }
+        return *this;
+    }
+
+    constexpr WideInt operator++(int) {
+        WideInt copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    constexpr WideInt& operator--() {
+        for (size_t i = 0; i < kWords; ++i) {
+            if (words[i]-- != 0) {
+                break;
+            }
+        }
+        return *this;
+    }
+
+    constexpr WideInt operator--(int) {
+        WideInt copy = *this;
+        --*this;
+        return copy;
+    }
+
+    constexpr WideInt& operator+=(const WideInt& wnum) {
+        DoubleWord transf = 0;
+        for (size_t i = 0; i < kWords; ++i) {
+            transf += static_cast<DoubleWord>(words[i]) + wnum.words[i];
+            words[i] = static_cast<uint64_t>(transf);
+            transf >>= 64;
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator-=(const WideInt& wnum) {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < kWords; ++i) {
+            uint64_t now = words[i] - wnum.words[i] - borrow;
+            borrow = words[i] < wnum.words[i] ||
+                             (words[i] == wnum.words[i] && borrow != 0)
+                         ? 1
+                         : 0;
+            words[i] = now;
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator*=(const WideInt& wnum) {
+        uint64_t res[kWords] = {};
+        for (size_t i = 0; i < kWords; ++i) {
+            DoubleWord transf = 0;
+            for (size_t j = 0; i + j < kWords; ++j) {
+                transf += static_cast<DoubleWord>(words[i]) * wnum.words[j] +
+                          res[i + j];
+                res[i + j] = static_cast<uint64_t>(transf);
+                transf >>= 64;
+            }
+        }
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = res[i];
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator/=(const WideInt& wnum) {
+        WideInt quotient, remainder;
+        divModAbs(magnitude(), wnum.magnitude(), quotient, remainder);
+        return *this = isNegative() != wnum.isNegative() ? -quotient
+                                                         : quotient;
+    }
+
+    constexpr WideInt& operator%=(const WideInt& wnum) {
+        WideInt quotient, remainder;
+        divModAbs(magnitude(), wnum.magnitude(), quotient, remainder);
+        return *this = isNegative() != wnum.isNegative() ? -remainder
+                                                         : remainder;
+    }
+
+    constexpr WideInt& operator&=(const WideInt& wnum) {
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] &= wnum.words[i];
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator|=(const WideInt& wnum) {
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] |= wnum.words[i];
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator^=(const WideInt& wnum) {
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] ^= wnum.words[i];
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator<<=(size_t shift) {
+        size_t word_shift = std::min(shift / 64, kWords);
+        int bit_shift = static_cast<int>(shift % 64);
+        for (size_t i = kWords; i-- > 0;) {
+            uint64_t now = i >= word_shift ? words[i - word_shift] << bit_shift
+                                           : 0;
+            if (bit_shift != 0 && i > word_shift) {
+                now |= words[i - word_shift - 1] >> (64 - bit_shift);
+            }
+            words[i] = now;
+        }
+        return *this;
+    }
+
+    constexpr WideInt& operator>>=(size_t shift) {
+        uint64_t fill = isNegative() ? ~uint64_t(0) : 0;
+        size_t word_shift = std::min(shift / 64, kWords);
+        int bit_shift = static_cast<int>(shift % 64);
+        for (size_t i = 0; i < kWords; ++i) {
+            uint64_t low = i + word_shift < kWords ? words[i + word_shift]
+                                                   : fill;
+            uint64_t high = i + word_shift + 1 < kWords
+                                ? words[i + word_shift + 1]
+                                : fill;
+            words[i] = bit_shift == 0
+                           ? low
+                           : low >> bit_shift | high << (64 - bit_shift);
+        }
+        return *this;
+    }
+
+    constexpr size_t popcount() const {
+        WideInt copy = magnitude();
+        size_t res = 0;
+        for (size_t i = 0; i < kWords; ++i) {
+            res += std::popcount(copy.words[i]);
+        }
+        return res;
+    }
+
+    friend constexpr WideInt operator+(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 += wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator-(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 -= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator*(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 *= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator/(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 /= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator%(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 %= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator&(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 &= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator|(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 |= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator^(WideInt wnum1, const WideInt& wnum2) {
+        wnum1 ^= wnum2;
+        return wnum1;
+    }
+
+    friend constexpr WideInt operator<<(WideInt wnum, size_t shift) {
+        wnum <<= shift;
+        return wnum;
+    }
+
+    friend constexpr WideInt operator>>(WideInt wnum, size_t shift) {
+        wnum >>= shift;
+        return wnum;
+    }
+
+    friend constexpr bool operator==(const WideInt& wnum1,
+                                     const WideInt& wnum2) {
+        return compareUnsigned(wnum1, wnum2) == 0;
+    }
+
+    friend constexpr bool operator!=(const WideInt& wnum1,
+                                     const WideInt& wnum2) {
+        return !(wnum1 == wnum2);
+    }
+
+    friend constexpr bool operator<(const WideInt& wnum1,
+                                    const WideInt& wnum2) {
+        if (wnum1.isNegative() != wnum2.isNegative()) {
+            return wnum1.isNegative();
+        }
+        return compareUnsigned(wnum1, wnum2) < 0;
+    }
+
+    friend constexpr bool operator>=(const WideInt& wnum1,
+                                     const WideInt& wnum2) {
+        return !(wnum1 < wnum2);
+    }
+
+    friend constexpr bool operator>(const WideInt& wnum1,
+                                    const WideInt& wnum2) {
+        return wnum2 < wnum1;
+    }
+
+    friend constexpr bool operator<=(const WideInt& wnum1,
+                                     const WideInt& wnum2) {
+        return !(wnum2 < wnum1);
+    }
+};
+
+using Int128 = WideInt<128>;
+
+using Int256 = WideInt<256>;
+
+using Int512 = WideInt<512>;
+
+using Int1024 = WideInt<1024>;
 
 class BigInteger {
   private:
-    static const int kNumSys = 1'000'000'000, kDigLen = 9;
+    using Limb = uint32_t;
+    using DoubleLimb = uint64_t;
+
+    class LimbBuffer {
+      private:
+        static const size_t kInlineCap = 8;
+
+        union Storage {
+            Limb* heap;
+            Limb local[kInlineCap];
+        };
+
+        size_t sz;
+        size_t cap;
+        Storage storage;
+        std::pmr::memory_resource* resource;
+
+        void release();
+
+      public:
+        LimbBuffer();
+
+        explicit LimbBuffer(std::pmr::memory_resource* memory);
+
+        LimbBuffer(const LimbBuffer& buffer);
+
+        LimbBuffer(LimbBuffer&& buffer) noexcept;
+
+        LimbBuffer& operator=(const LimbBuffer& buffer);
+
+        LimbBuffer& operator=(LimbBuffer&& buffer);
+
+        ~LimbBuffer();
+
+        void swap(LimbBuffer& buffer) noexcept;
+
+        void adopt(LimbBuffer& buffer);
+
+        std::pmr::memory_resource* memoryResource() const {
+            return resource != nullptr ? resource
+                                       : std::pmr::new_delete_resource();
+        }
+
+        const Limb* data() const {
+            return cap == kInlineCap ? storage.local : storage.heap;
+        }
+
+        Limb* data() {
+            return cap == kInlineCap ? storage.local : storage.heap;
+        }
+
+        const Limb& operator[](size_t pos) const {
+            return data()[pos];
+        }
+
+        Limb& operator[](size_t pos) {
+            return data()[pos];
+        }
+
+        size_t size() const {
+            return sz;
+        }
+
+        bool empty() const {
+            return sz == 0;
+        }
+
+        const Limb* begin() const {
+            return data();
+        }
+
+        const Limb* end() const {
+            return data() + sz;
+        }
+
+        Limb& back() {
+            return data()[sz - 1];
+        }
+
+        void push_back(Limb limb) {
+            if (sz == cap) {
+                reserve(cap * 2);
+            }
+            data()[sz++] = limb;
+        }
+
+        void pop_back() {
+            --sz;
+        }
+
+        void clear() {
+            sz = 0;
+        }
+
+        void reserve(size_t new_cap);
+
+        void resize(size_t new_sz);
+
+        void assign(const Limb* first, const Limb* last);
+
+        void insertZeros(size_t count);
+    };
+
+    class ScratchArena {
+      private:
+        static constexpr size_t kMinBlock = 1 << 12;
+        std::vector<std::unique_ptr<Limb[]>> blocks;
+        std::vector<size_t> sizes;
+        size_t block = 0;
+        size_t used = 0;
+
+      public:
+        class Frame {
+          private:
+            ScratchArena& arena;
+            size_t block;
+            size_t used;
+
+          public:
+            Frame();
+
+            Frame(const Frame& frame) = delete;
+
+            Frame& operator=(const Frame& frame) = delete;
+
+            ~Frame();
+
+            Limb* allocate(size_t count);
+        };
+
+        static ScratchArena& local();
+    };
+
+    static constexpr DoubleLimb kNumSys = DoubleLimb(1) << 32;
+    static const Limb kDecNumSys = 1'000'000'000;
+    static const size_t kDigLen = 9;
+    static const size_t kKaratsubaThreshold = 40, kToomThreshold = 1500,
+                        kNttThreshold = 16000, kMaxNttLength = 1 << 24,
+                        kNttSplitThreshold = 1 << 21,
+                        kNewtonThreshold = 1000, kConversionThreshold = 150,
+                        kParallelThreshold = 10000,
+                        kBinomialSieveRatio = 64, kSimdThreshold = 16;
+    static const uint32_t kNttMod1 = 167'772'161, kNttMod2 = 469'762'049,
+                          kNttMod3 = 754'974'721;
     bool isNegative;
-    std::deque<int> digits;
+    LimbBuffer digits;
 
     void swap(BigInteger& bnum);
 
     void removeLeadingZeros();
 
+    BigInteger limbSlice(size_t start, size_t count) const;
+
+    void shiftLimbs(size_t count);
+
+    Limb divideByLimb(Limb divisor);
+
+    void mulAddLimb(Limb mul, Limb add);
+
+    static Limb addLimbs(Limb* res, size_t res_len, const Limb* bnum,
+                         size_t bnum_len);
+
+    static void subLimbs(Limb* res, size_t res_len, const Limb* bnum,
+                         size_t bnum_len);
+
+    static void subReversedLimbs(Limb* res, const Limb* bnum, size_t len);
+
+    static void sqrSchoolbook(const Limb* bnum, size_t len, Limb* res);
+
+    static void sqrKaratsuba(const Limb* bnum, size_t len, Limb* res,
+                             Limb* scratch);
+
+    static void mulSchoolbook(const Limb* bnum1, size_t len1,
+                              const Limb* bnum2, size_t len2, Limb* res);
+
+    static size_t mulScratchSize(size_t len1, size_t len2);
+
+    static void mulKaratsuba(const Limb* bnum1, const Limb* bnum2, size_t len,
+                             Limb* res, Limb* scratch);
+
+    static void mulLimbs(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                         size_t len2, Limb* res, Limb* scratch);
+
+    static uint32_t powModWord(DoubleLimb base, DoubleLimb exp, uint32_t mod);
+
+    // One thread of a team started by runWorkers(). Every worker runs the
+    // same stages on its own range and meets the others in wait() before
+    // the next stage reads what they wrote.
+    struct Worker {
+        size_t rank;
+        size_t count;
+        std::barrier<>& sync;
+
+        std::pair<size_t, size_t> range(size_t total) const;
+
+        void wait() const;
+    };
+
+    template <class Func>
+    static void runWorkers(size_t threads, Func func);
+
+    template <uint32_t kMod>
+    static void transformNtt(std::vector<uint32_t>& poly,
+                             const std::vector<uint32_t>& roots,
+                             const Worker& worker);
+
+    template <uint32_t kMod, uint32_t kRoot>
+    static void convolveNtt(const std::vector<uint32_t>& pieces1,
+                            const std::vector<uint32_t>& pieces2,
+                            std::vector<uint32_t>& res,
+                            std::vector<uint32_t>& other,
+                            std::vector<uint32_t>& roots,
+                            const Worker& worker);
+
+    static void mulNtt(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                       size_t len2, Limb* res, size_t threads);
+
+    static BigInteger mulToom3(const BigInteger& bnum1, const BigInteger& bnum2,
+                               size_t threads);
+
+    static void mulMagnitudes(const BigInteger& bnum1, const BigInteger& bnum2,
+                              LimbBuffer& res, size_t threads = 1);
+
+    static int compareLimbs(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                            size_t len2);
+
+    void addSigned(const Limb* bnum, size_t len, bool negative);
+
+    static void divKnuth(const Limb* bnum1, size_t len1, const Limb* bnum2,
+                         size_t len2, Limb* quotient, Limb* remainder);
+
+    static BigInteger reciprocal(const BigInteger& bnum);
+
+    static void divModNewton(const BigInteger& bnum1, const BigInteger& bnum2,
+                             const BigInteger& recip, BigInteger& quotient,
+                             BigInteger& remainder);
+
+    static void divModAbs(const BigInteger& bnum1, const BigInteger& bnum2,
+                          BigInteger& quotient, BigInteger& remainder);
+
+    static const std::pair<BigInteger, BigInteger>& decPower(size_t level);
+
+    static void divModDecPower(const BigInteger& bnum, size_t level,
+                               BigInteger& quotient, BigInteger& remainder);
+
+    static char* writeDecimal(const BigInteger& bnum, char* buf);
+
+    static char* writeDecimalPadded(const BigInteger& bnum, size_t level,
+                                    char* buf);
+
+    static BigInteger parseDecimal(std::string_view str);
+
+    static BigInteger fromWord(DoubleLimb num, bool negative = false);
+
+    DoubleLimb lowWord() const;
+
+    size_t bitLength() const;
+
+    DoubleLimb topBits(size_t shift) const;
+
+    template <std::integral T>
+    static DoubleLimb wordMagnitude(T num);
+
+    void addWord(DoubleLimb num, bool negative);
+
+    void mulWord(DoubleLimb num, bool negative);
+
+    DoubleLimb divWord(DoubleLimb num);
+
+    template <class Op>
+    void applyBitwise(const BigInteger& bnum, Op op);
+
+    static DoubleLimb gcdWord(DoubleLimb num1, DoubleLimb num2);
+
+    static void applyLehmer(BigInteger& bnum1, BigInteger& bnum2, int64_t a,
+                            int64_t b, int64_t c, int64_t d);
+
+    static BigInteger gcdLehmer(BigInteger bnum1, BigInteger bnum2,
+                                BigInteger* coef);
+
+    static DoubleLimb rootWord(DoubleLimb num, unsigned degree);
+
+    static BigInteger rootNewton(const BigInteger& bnum, unsigned degree);
+
+    static BigInteger reduceMod(const BigInteger& bnum, const BigInteger& mod);
+
+    template <class Mul>
+    static BigInteger powWindow(const BigInteger& base, const BigInteger& exp,
+                                const BigInteger& one, Mul mul);
+
+    static std::vector<uint64_t> primesUpTo(uint64_t num);
+
+    static BigInteger productOfWords(const std::vector<DoubleLimb>& words,
+                                     size_t threads);
+
+    static BigInteger oddFactorial(uint64_t num,
+                                   const std::vector<uint64_t>& primes,
+                                   size_t threads);
+
+    static thread_local std::pmr::memory_resource* threadResource;
+
+    static std::pmr::memory_resource* heapOrResource(
+        std::pmr::memory_resource* resource);
+
+    friend class MontgomeryContext;
+
+    friend class BigIntegerMemoryScope;
+
   public:
     BigInteger();
 
+    explicit BigInteger(std::pmr::memory_resource* resource);
+
+    BigInteger(const BigInteger& bnum, std::pmr::memory_resource* resource);
+
     BigInteger(int num);
 
     BigInteger(std::string s);
 
-    explicit operator bool() const;
+    template <size_t kBits>
+    explicit BigInteger(const FixedBigInteger<kBits>& fnum);
 
-    const int& operator[](size_t pos) const;
+    template <size_t kBits>
+    explicit BigInteger(const WideInt<kBits>& wnum);
 
-    int& operator[](size_t pos);
+    explicit operator bool() const;
+
+    uint32_t limb(size_t pos) const;
 
-    size_t numLength() const;
+    size_t limbCount() const;
 
     int numSign() const;
 
     void clear();
 
-    BigInteger operator-() const;
+    void negate();
+
+    BigInteger operator-() const&;
+
+    BigInteger operator-() &&;
+
+    BigInteger operator~() const;
 
     BigInteger& operator++();
 
@@ -47,23 +1184,239 @@ class BigInteger {
 
     BigInteger& operator*=(const BigInteger& bnum);
 
-    BigInteger& operator/=(BigInteger bnum);
+    BigInteger& operator/=(const BigInteger& bnum);
+
+    BigInteger& operator%=(const BigInteger& bnum);
+
+    BigInteger& operator&=(const BigInteger& bnum);
+
+    BigInteger& operator|=(const BigInteger& bnum);
+
+    BigInteger& operator^=(const BigInteger& bnum);
 
-    BigInteger& operator%=(BigInteger bnum);
+    BigInteger& operator<<=(size_t shift);
+
+    BigInteger& operator>>=(size_t shift);
+
+    size_t popcount() const;
+
+    template <std::integral T>
+    BigInteger& operator+=(T num);
+
+    template <std::integral T>
+    BigInteger& operator-=(T num);
+
+    template <std::integral T>
+    BigInteger& operator*=(T num);
+
+    template <std::integral T>
+    BigInteger& operator/=(T num);
+
+    template <std::integral T>
+    BigInteger& operator%=(T num);
+
+    void reserve(size_t limbs);
+
+    BigInteger& addmul(const BigInteger& bnum1, const BigInteger& bnum2);
+
+    BigInteger& submul(const BigInteger& bnum1, const BigInteger& bnum2);
 
     std::string toString() const;
 
+    size_t maxCharsLength() const;
+
+    char* toChars(char* buf) const;
+
+    static BigInteger fromChars(std::string_view str);
+
+    size_t serializedSize() const;
+
+    size_t serialize(std::span<std::byte> buf) const;
+
+    size_t deserialize(std::span<const std::byte> buf);
+
+    std::pmr::memory_resource* memoryResource() const;
+
     void siftLeft();
-};
 
-BigInteger operator""_bi(unsigned long long num);
+    friend bool operator==(const BigInteger& bnum1, const BigInteger& bnum2);
 
-BigInteger operator""_bi(const char* str, size_t /*unused*/);
+    friend bool operator<(const BigInteger& bnum1, const BigInteger& bnum2);
+
+    friend BigInteger multiply(const BigInteger& bnum1,
+                               const BigInteger& bnum2, size_t threads);
+
+    friend std::pair<BigInteger, BigInteger> divmod(const BigInteger& bnum1,
+                                                    const BigInteger& bnum2);
+
+    template <std::integral T>
+    friend std::pair<BigInteger, BigInteger> divmod(const BigInteger& bnum,
+                                                    T num);
+
+    friend BigInteger powmod(const BigInteger& base, const BigInteger& exp,
+                             const BigInteger& mod);
+
+    friend BigInteger iroot(const BigInteger& bnum, unsigned degree);
+
+    friend BigInteger productOf(std::vector<BigInteger> factors,
+                                size_t threads);
+
+    friend BigInteger factorial(uint64_t num, size_t threads);
+
+    friend BigInteger binomial(uint64_t num, uint64_t choose, size_t threads);
+
+    friend BigInteger gcd(const BigInteger& bnum1, const BigInteger& bnum2);
+
+    friend BigInteger extendedGcd(const BigInteger& bnum1,
+                                  const BigInteger& bnum2, BigInteger& coef1,
+                                  BigInteger& coef2);
+};
+
+template <std::integral T>
+BigInteger::DoubleLimb BigInteger::wordMagnitude(T num) {
+    if (std::cmp_less(num, 0)) {
+        return -static_cast<DoubleLimb>(num);
+    }
+    return static_cast<DoubleLimb>(num);
+}
+
+template <std::integral T>
+BigInteger& BigInteger::operator+=(T num) {
+    addWord(wordMagnitude(num), std::cmp_less(num, 0));
+    return *this;
+}
+
+template <std::integral T>
+BigInteger& BigInteger::operator-=(T num) {
+    addWord(wordMagnitude(num), !std::cmp_less(num, 0));
+    return *this;
+}
+
+template <std::integral T>
+BigInteger& BigInteger::operator*=(T num) {
+    mulWord(wordMagnitude(num), std::cmp_less(num, 0));
+    return *this;
+}
+
+template <std::integral T>
+BigInteger& BigInteger::operator/=(T num) {
+    bool res_negative = isNegative != std::cmp_less(num, 0);
+    divWord(wordMagnitude(num));
+    isNegative = res_negative;
+    return *this;
+}
+
+template <std::integral T>
+BigInteger& BigInteger::operator%=(T num) {
+    bool res_negative = isNegative != std::cmp_less(num, 0);
+    *this = fromWord(divWord(wordMagnitude(num)), res_negative);
+    return *this;
+}
+
+template <size_t kBits>
+BigInteger::BigInteger(const FixedBigInteger<kBits>& fnum)
+    : isNegative(fnum.numSign() < 0) {
+    digits.assign(fnum.digits, fnum.digits + fnum.length);
+}
+
+template <size_t kBits>
+BigInteger::BigInteger(const WideInt<kBits>& wnum)
+    : isNegative(wnum.isNegative()) {
+    WideInt<kBits> abs_num = wnum.magnitude();
+    digits.resize(2 * WideInt<kBits>::kWords);
+    for (size_t i = 0; i < WideInt<kBits>::kWords; ++i) {
+        digits[2 * i] = static_cast<Limb>(abs_num.words[i]);
+        digits[2 * i + 1] = static_cast<Limb>(abs_num.words[i] >> 32);
+    }
+    removeLeadingZeros();
+}
+
+template <size_t kBits>
+WideInt<kBits>::WideInt(const BigInteger& bnum) {
+    if (bnum.limbCount() > 2 * kWords) {
+        throw std::overflow_error("");
+    }
+    for (size_t i = 0; i < bnum.limbCount(); ++i) {
+        words[i / 2] |= static_cast<uint64_t>(bnum.limb(i)) << (i % 2 * 32);
+    }
+    bool negative = bnum.numSign() < 0;
+    if (isNegative()) {
+        bool is_min = negative && words[kWords - 1] << 1 == 0;
+        for (size_t i = 0; is_min && i + 1 < kWords; ++i) {
+            is_min = words[i] == 0;
+        }
+        if (!is_min) {
+            throw std::overflow_error("");
+        }
+    }
+    if (negative) {
+        *this = -*this;
+    }
+}
+
+template <size_t kBits>
+std::string WideInt<kBits>::toString() const {
+    return BigInteger(*this).toString();
+}
+
+template <size_t kBits>
+FixedBigInteger<kBits>::FixedBigInteger(const BigInteger& bnum)
+    : isNegative(bnum.numSign() < 0 && bnum) {
+    if (bnum.limbCount() > kLimbs) {
+        throw std::overflow_error("");
+    }
+    length = bnum.limbCount();
+    for (size_t i = 0; i < length; ++i) {
+        digits[i] = bnum.limb(i);
+    }
+    checkOverflow();
+}
+
+// The digits are parsed at compile time and the limbs live in a constant,
+// but each use still builds a BigInteger from them. Literals wider than
+// the inline limb buffer (256 bits) allocate that copy at the point of use.
+template <char... kChars>
+BigInteger operator""_bi() {
+    static constexpr size_t kBits = 4 * sizeof...(kChars);
+    static constexpr char kStr[] = {kChars...};
+    static constexpr FixedBigInteger<kBits> kValue =
+        FixedBigInteger<kBits>::fromLiteral(
+            std::string_view(kStr, sizeof...(kChars)));
+    return BigInteger(kValue);
+}
+
+template <BigIntegerLiteral kStr>
+BigInteger operator""_bi() {
+    static constexpr size_t kBits = 4 * sizeof(kStr.chars);
+    static constexpr FixedBigInteger<kBits> kValue =
+        FixedBigInteger<kBits>::fromChars(
+            std::string_view(kStr.chars, sizeof(kStr.chars) - 1));
+    return BigInteger(kValue);
+}
 
 std::istream& operator>>(std::istream& in, BigInteger& bnum);
 
 std::ostream& operator<<(std::ostream& out, const BigInteger& bnum);
 
+template <size_t kBits>
+std::ostream& operator<<(std::ostream& out,
+                         const FixedBigInteger<kBits>& fnum) {
+    return out << BigInteger(fnum);
+}
+
+template <size_t kBits>
+std::istream& operator>>(std::istream& in, WideInt<kBits>& wnum) {
+    BigInteger bnum;
+    in >> bnum;
+    wnum = WideInt<kBits>(bnum);
+    return in;
+}
+
+template <size_t kBits>
+std::ostream& operator<<(std::ostream& out, const WideInt<kBits>& wnum) {
+    return out << BigInteger(wnum);
+}
+
 bool operator==(const BigInteger& bnum1, const BigInteger& bnum2);
 
 bool operator!=(const BigInteger& bnum1, const BigInteger& bnum2);
@@ -78,24 +1431,215 @@ bool operator<=(const BigInteger& bnum1, const BigInteger& bnum2);
 
 BigInteger operator+(BigInteger bnum1, const BigInteger& bnum2);
 
+BigInteger operator+(const BigInteger& bnum1, BigInteger&& bnum2);
+
+BigInteger operator+(BigInteger&& bnum1, BigInteger&& bnum2);
+
 BigInteger operator-(BigInteger bnum1, const BigInteger& bnum2);
 
 BigInteger operator*(BigInteger bnum1, const BigInteger& bnum2);
 
+BigInteger operator*(const BigInteger& bnum1, BigInteger&& bnum2);
+
+BigInteger operator*(BigInteger&& bnum1, BigInteger&& bnum2);
+
 BigInteger operator/(BigInteger bnum1, const BigInteger& bnum2);
 
 BigInteger operator%(BigInteger bnum1, const BigInteger& bnum2);
 
+template <std::integral T>
+BigInteger operator+(BigInteger bnum, T num) {
+    bnum += num;
+    return bnum;
+}
+
+template <std::integral T>
+BigInteger operator-(BigInteger bnum, T num) {
+    bnum -= num;
+    return bnum;
+}
+
+template <std::integral T>
+BigInteger operator*(BigInteger bnum, T num) {
+    bnum *= num;
+    return bnum;
+}
+
+template <std::integral T>
+BigInteger operator*(T num, BigInteger bnum) {
+    bnum *= num;
+    return bnum;
+}
+
+template <std::integral T>
+BigInteger operator/(BigInteger bnum, T num) {
+    bnum /= num;
+    return bnum;
+}
+
+template <std::integral T>
+BigInteger operator%(BigInteger bnum, T num) {
+    bnum %= num;
+    return bnum;
+}
+
+BigInteger operator&(BigInteger bnum1, const BigInteger& bnum2);
+
+BigInteger operator|(BigInteger bnum1, const BigInteger& bnum2);
+
+BigInteger operator^(BigInteger bnum1, const BigInteger& bnum2);
+
+BigInteger operator<<(BigInteger bnum, size_t shift);
+
+BigInteger operator>>(BigInteger bnum, size_t shift);
+
+BigInteger multiply(const BigInteger& bnum1, const BigInteger& bnum2,
+                    size_t threads);
+
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& bnum1,
+                                         const BigInteger& bnum2);
+
+template <std::integral T>
+std::pair<BigInteger, BigInteger> divmod(const BigInteger& bnum, T num) {
+    std::pair<BigInteger, BigInteger> res(bnum, BigInteger());
+    bool res_negative = bnum.isNegative != std::cmp_less(num, 0);
+    res.second = BigInteger::fromWord(
+        res.first.divWord(BigInteger::wordMagnitude(num)), res_negative);
+    res.first.isNegative = res_negative;
+    return res;
+}
+
+BigInteger pow(const BigInteger& base, uint64_t exp);
+
+BigInteger powmod(const BigInteger& base, const BigInteger& exp,
+                  const BigInteger& mod);
+
+BigInteger isqrt(const BigInteger& bnum);
+
+BigInteger iroot(const BigInteger& bnum, unsigned degree);
+
+BigInteger productOf(std::vector<BigInteger> factors, size_t threads = 1);
+
+template <std::ranges::input_range Range>
+BigInteger productOf(Range&& range, size_t threads = 1) {
+    std::vector<BigInteger> factors;
+    for (auto&& elem : range) {
+        if constexpr (std::integral<std::ranges::range_value_t<Range>>) {
+            factors.emplace_back();
+            factors.back() += elem;
+        } else {
+            factors.emplace_back(elem);
+        }
+    }
+    return productOf(std::move(factors), threads);
+}
+
+BigInteger factorial(uint64_t num, size_t threads = 1);
+
+BigInteger binomial(uint64_t num, uint64_t choose, size_t threads = 1);
+
+BigInteger gcd(const BigInteger& bnum1, const BigInteger& bnum2);
+
+BigInteger extendedGcd(const BigInteger& bnum1, const BigInteger& bnum2,
+                       BigInteger& coef1, BigInteger& coef2);
+
+BigInteger lcm(const BigInteger& bnum1, const BigInteger& bnum2);
+
+class BigIntegerMemoryScope {
+  private:
+    std::pmr::memory_resource* previous;
+
+  public:
+    explicit BigIntegerMemoryScope(std::pmr::memory_resource* resource);
+
+    BigIntegerMemoryScope(const BigIntegerMemoryScope& scope) = delete;
+
+    BigIntegerMemoryScope& operator=(const BigIntegerMemoryScope& scope) =
+        delete;
+
+    ~BigIntegerMemoryScope();
+};
+
+class BigIntegerArena {
+  private:
+    std::pmr::unsynchronized_pool_resource pool;
+    BigIntegerMemoryScope scope;
+
+  public:
+    BigIntegerArena();
+
+    explicit BigIntegerArena(std::pmr::memory_resource* upstream);
+
+    std::pmr::memory_resource* resource();
+};
+
+template <class Allocator>
+class AllocatorResource : public std::pmr::memory_resource {
+  private:
+    using Block = std::max_align_t;
+    using BlockAllocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<Block>;
+    BlockAllocator allocator;
+
+    static size_t blocks(size_t bytes) {
+        return (bytes + sizeof(Block) - 1) / sizeof(Block);
+    }
+
+    void* do_allocate(size_t bytes, size_t /*unused*/) override {
+        return std::allocator_traits<BlockAllocator>::allocate(allocator,
+                                                               blocks(bytes));
+    }
+
+    void do_deallocate(void* ptr, size_t bytes,
+                       size_t /*unused*/) override {
+        std::allocator_traits<BlockAllocator>::deallocate(
+            allocator, static_cast<Block*>(ptr), blocks(bytes));
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+  public:
+    explicit AllocatorResource(const Allocator& alloc) : allocator(alloc) {}
+};
+
+class MontgomeryContext {
+  private:
+    BigInteger modulus, rSquared, negInverse;
+    uint32_t wordInverse;
+
+    BigInteger reduce(BigInteger bnum) const;
+
+  public:
+    explicit MontgomeryContext(const BigInteger& mod);
+
+    BigInteger toMontgomery(const BigInteger& bnum) const;
+
+    BigInteger fromMontgomery(const BigInteger& bnum) const;
+
+    BigInteger multiply(const BigInteger& bnum1,
+                        const BigInteger& bnum2) const;
+
+    BigInteger pow(const BigInteger& base, const BigInteger& exp) const;
+};
+
 class Rational {
   private:
     BigInteger numerator, denominator;
 
-    BigInteger gcd(BigInteger bnum1, BigInteger bnum2);
-
     void reduceFraction();
 
+    void addFraction(const BigInteger& num, const BigInteger& den);
+
     void swap(Rational& rnum);
 
+    template <std::floating_point Float>
+    Float toFloating() const;
+
+    friend class RationalAccumulator;
+
   public:
     Rational();
 
@@ -103,6 +1647,8 @@ class Rational {
 
     Rational(BigInteger bnum);
 
+    Rational(const Rational& rnum, std::pmr::memory_resource* resource);
+
     BigInteger getNumerator() const;
 
     BigInteger getDenominator() const;
@@ -121,7 +1667,19 @@ class Rational {
 
     std::string asDecimal(size_t precision = 0) const;
 
+    size_t maxDecimalLength(size_t precision) const;
+
+    char* asDecimal(char* buf, size_t precision) const;
+
+    size_t serializedSize() const;
+
+    size_t serialize(std::span<std::byte> buf) const;
+
+    size_t deserialize(std::span<const std::byte> buf);
+
     explicit operator double() const;
+
+    explicit operator long double() const;
 };
 
 Rational operator+(Rational rnum1, const Rational& rnum2);
@@ -143,3 +1701,133 @@ bool operator>=(const Rational& rnum1, const Rational& rnum2);
 bool operator>(const Rational& rnum1, const Rational& rnum2);
 
 bool operator<=(const Rational& rnum1, const Rational& rnum2);
+
+class RationalAccumulator {
+  private:
+    static constexpr size_t kReduceThreshold = 32;
+    BigInteger numerator, denominator;
+    size_t reducedLength;
+
+    void reduceIfLarge();
+
+    static int compare(const BigInteger& num1, const BigInteger& den1,
+                       const BigInteger& num2, const BigInteger& den2);
+
+    static int compare(const RationalAccumulator& acc1,
+                       const RationalAccumulator& acc2);
+
+    static int compare(const RationalAccumulator& acc, const Rational& rnum);
+
+  public:
+    RationalAccumulator();
+
+    RationalAccumulator(const Rational& rnum);
+
+    RationalAccumulator& operator+=(const Rational& rnum);
+
+    RationalAccumulator& operator-=(const Rational& rnum);
+
+    RationalAccumulator& operator*=(const Rational& rnum);
+
+    RationalAccumulator& operator/=(const Rational& rnum);
+
+    Rational normalize() const;
+
+    operator Rational() const;
+
+    std::string toString() const;
+
+    std::string asDecimal(size_t precision = 0) const;
+
+    explicit operator double() const;
+
+    explicit operator long double() const;
+
+    friend bool operator==(const RationalAccumulator& acc1,
+                           const RationalAccumulator& acc2);
+
+    friend bool operator==(const RationalAccumulator& acc,
+                           const Rational& rnum);
+
+    friend bool operator==(const Rational& rnum,
+                           const RationalAccumulator& acc);
+
+    friend bool operator<(const RationalAccumulator& acc1,
+                          const RationalAccumulator& acc2);
+
+    friend bool operator<(const RationalAccumulator& acc, const Rational& rnum);
+
+    friend bool operator<(const Rational& rnum, const RationalAccumulator& acc);
+};
+
+bool operator==(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2);
+
+bool operator==(const RationalAccumulator& acc, const Rational& rnum);
+
+bool operator==(const Rational& rnum, const RationalAccumulator& acc);
+
+bool operator!=(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2);
+
+bool operator!=(const RationalAccumulator& acc, const Rational& rnum);
+
+bool operator!=(const Rational& rnum, const RationalAccumulator& acc);
+
+bool operator<(const RationalAccumulator& acc1,
+               const RationalAccumulator& acc2);
+
+bool operator<(const RationalAccumulator& acc, const Rational& rnum);
+
+bool operator<(const Rational& rnum, const RationalAccumulator& acc);
+
+bool operator>=(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2);
+
+bool operator>=(const RationalAccumulator& acc, const Rational& rnum);
+
+bool operator>=(const Rational& rnum, const RationalAccumulator& acc);
+
+bool operator>(const RationalAccumulator& acc1,
+               const RationalAccumulator& acc2);
+
+bool operator>(const RationalAccumulator& acc, const Rational& rnum);
+
+bool operator>(const Rational& rnum, const RationalAccumulator& acc);
+
+bool operator<=(const RationalAccumulator& acc1,
+                const RationalAccumulator& acc2);
+
+bool operator<=(const RationalAccumulator& acc, const Rational& rnum);
+
+bool operator<=(const Rational& rnum, const RationalAccumulator& acc);
+
+class BigIntegerWriter {
+  private:
+    std::ostream& out;
+    std::vector<std::byte> buffer;
+
+  public:
+    explicit BigIntegerWriter(std::ostream& stream);
+
+    BigIntegerWriter& operator<<(const BigInteger& bnum);
+
+    BigIntegerWriter& operator<<(const Rational& rnum);
+};
+
+class BigIntegerReader {
+  private:
+    std::span<const std::byte> data;
+    size_t pos;
+
+  public:
+    explicit BigIntegerReader(std::span<const std::byte> buf);
+
+    bool atEnd() const;
+
+    size_t position() const;
+
+    BigIntegerReader& operator>>(BigInteger& bnum);
+
+    BigIntegerReader& operator>>(Rational& rnum);
+};
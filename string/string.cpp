@@ -1,67 +1,208 @@
 #include "string.h"
 
-void String::Swap(String& str) {
+#include <bit>
+#include <functional>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+void String::allocate(size_t n) {
+    cap = std::max(n, kLocalCap);
+    if (cap != kLocalCap) {
+        storage.arr = new char[cap + 1];
+    }
+}
+
+void String::release() {
+    if (cap != kLocalCap) {
+        delete[] storage.arr;
+    }
+}
+
+void String::Swap(String& str) noexcept {
     std::swap(cap, str.cap);
     std::swap(sz, str.sz);
-    std::swap(arr, str.arr);
+    std::swap(storage, str.storage);
+}
+
+void String::reallocate(size_t new_cap) {
+    char* new_arr = new char[new_cap + 1];
+    std::copy(data(), data() + sz + 1, new_arr);
+    release();
+    cap = new_cap;
+    storage.arr = new_arr;
 }
 
 void String::raiseCapIfRequired(size_t req_sz) {
     if (cap - sz >= req_sz) {
         return;
     }
-    while (cap - sz < req_sz) {
-        cap = cap * 2 + 1;
+    size_t new_cap = cap;
+    while (new_cap - sz < req_sz) {
+        new_cap = new_cap * 2 + 1;
+    }
+    reallocate(new_cap);
+}
+
+size_t String::findShort(const char* text, size_t n, const char* pattern,
+                         size_t m) {
+    if (m > n) {
+        return n;
+    }
+    if (m == 1) {
+        const void* hit = memchr(text, pattern[0], n);
+        return hit != nullptr ? static_cast<const char*>(hit) - text : n;
+    }
+    size_t end = n - m + 1;
+    size_t i = 0;
+#ifdef __SSE2__
+    __m128i first = _mm_set1_epi8(pattern[0]);
+    __m128i last = _mm_set1_epi8(pattern[m - 1]);
+    for (; i + 16 <= end; i += 16) {
+        __m128i head = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(text + i));
+        __m128i tail = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(text + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        while (mask != 0) {
+            size_t pos = i + std::countr_zero(mask);
+            if (memcmp(text + pos + 1, pattern + 1, m - 2) == 0) {
+                return pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    while (i < end) {
+        const void* hit = memchr(text + i, pattern[0], end - i);
+        if (hit == nullptr) {
+            break;
+        }
+        i = static_cast<const char*>(hit) - text;
+        if (text[i + m - 1] == pattern[m - 1] &&
+            memcmp(text + i + 1, pattern + 1, m - 2) == 0) {
+            return i;
+        }
+        ++i;
+    }
+    return n;
+}
+
+size_t String::rfindShort(const char* text, size_t n, const char* pattern,
+                          size_t m) {
+    if (m > n) {
+        return n;
+    }
+    size_t end = n - m + 1;
+#ifdef __SSE2__
+    __m128i first = _mm_set1_epi8(pattern[0]);
+    __m128i last = _mm_set1_epi8(pattern[m - 1]);
+    for (; end >= 16; end -= 16) {
+        size_t i = end - 16;
+        __m128i head = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(text + i));
+        __m128i tail = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(text + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+        while (mask != 0) {
+            size_t bit = std::bit_width(mask) - 1;
+            if (m < 3 ||
+                memcmp(text + i + bit + 1, pattern + 1, m - 2) == 0) {
+                return i + bit;
+            }
+            mask ^= 1u << bit;
+        }
+    }
+#endif
+    while (end > 0) {
+        --end;
+        if (text[end] == pattern[0] && text[end + m - 1] == pattern[m - 1] &&
+            (m < 3 || memcmp(text + end + 1, pattern + 1, m - 2) == 0)) {
+            return end;
+        }
     }
-    char* new_arr = new char[cap + 1];
-    std::copy(arr, arr + sz + 1, new_arr);
-    std::swap(new_arr, arr);
-    delete[] new_arr;
+    return n;
 }
 
-bool String::checkSubstring(const String& substring, size_t pos) const {
-    return memcmp(arr + pos, substring.arr, substring.sz) == 0;
+String::String() : cap(kLocalCap), sz(0) {
+    storage.local[0] = '\0';
 }
 
-String::String() : cap(0), sz(0), arr(new char[1]) {
-    arr[0] = '\0';
+String::String(const char* c_str) : sz(strlen(c_str)) {
+    allocate(sz);
+    std::copy(c_str, c_str + sz + 1, data());
 }
 
-String::String(const char* c_str)
-    : cap(strlen(c_str)), sz(cap), arr(new char[cap + 1]) {
-    std::copy(c_str, c_str + cap + 1, arr);
+String::String(size_t n, char c) : sz(n) {
+    allocate(n);
+    std::fill(data(), data() + n, c);
+    data()[n] = '\0';
 }
 
-String::String(size_t n, char c) : cap(n), sz(n), arr(new char[n + 1]) {
-    std::fill(arr, arr + n, c);
-    arr[n] = '\0';
+String::String(char c) : cap(kLocalCap), sz(1) {
+    storage.local[0] = c;
+    storage.local[1] = '\0';
 }
 
-String::String(char c) : cap(1), sz(1), arr(new char[2]) {
-    arr[0] = c;
-    arr[1] = '\0';
+String::String(StringView str) : sz(str.size()) {
+    allocate(sz);
+    std::copy(str.data(), str.data() + sz, data());
+    data()[sz] = '\0';
 }
 
-String::String(const String& str)
-    : cap(str.cap), sz(str.sz), arr(new char[str.cap + 1]) {
-    std::copy(str.arr, str.arr + str.sz + 1, arr);
+String::String(const String& str) : sz(str.sz) {
+    allocate(str.cap);
+    std::copy(str.data(), str.data() + str.sz + 1, data());
 }
 
-String& String::operator=(String str) {
-    Swap(str);
+String::String(String&& str) noexcept
+    : cap(str.cap), sz(str.sz), storage(str.storage) {
+    str.cap = kLocalCap;
+    str.sz = 0;
+    str.storage.local[0] = '\0';
+}
+
+String& String::operator=(const String& str) {
+    if (this == &str) {
+        return *this;
+    }
+    if (cap < str.sz) {
+        String copy(str);
+        Swap(copy);
+        return *this;
+    }
+    sz = str.sz;
+    std::copy(str.data(), str.data() + str.sz + 1, data());
+    return *this;
+}
+
+String& String::operator=(String&& str) noexcept {
+    if (this == &str) {
+        return *this;
+    }
+    release();
+    cap = str.cap;
+    sz = str.sz;
+    storage = str.storage;
+    str.cap = kLocalCap;
+    str.sz = 0;
+    str.storage.local[0] = '\0';
     return *this;
 }
 
 String::~String() {
-    delete[] arr;
+    release();
 }
 
 const char& String::operator[](size_t id) const {
-    return arr[id];
+    return data()[id];
 }
 
 char& String::operator[](size_t id) {
-    return arr[id];
+    return data()[id];
 }
 
 size_t String::length() const {
@@ -70,28 +211,28 @@ size_t String::length() const {
 
 void String::push_back(char c) {
     raiseCapIfRequired(1);
-    arr[sz] = c;
-    arr[++sz] = '\0';
+    data()[sz] = c;
+    data()[++sz] = '\0';
 }
 
 void String::pop_back() {
-    arr[--sz] = '\0';
+    data()[--sz] = '\0';
 }
 
 const char& String::front() const {
-    return arr[0];
+    return data()[0];
 }
 
 char& String::front() {
-    return arr[0];
+    return data()[0];
 }
 
 const char& String::back() const {
-    return arr[sz - 1];
+    return data()[sz - 1];
 }
 
 char& String::back() {
-    return arr[sz - 1];
+    return data()[sz - 1];
 }
 
 String& String::operator+=(char c) {
@@ -99,29 +240,28 @@ String& String::operator+=(char c) {
     return *this;
 }
 
-String& String::operator+=(const String& str) {
-    raiseCapIfRequired(str.sz);
-    std::copy(str.arr, str.arr + str.sz + 1, arr + sz);
-    sz += str.sz;
+String& String::operator+=(StringView str) {
+    const char* src = str.data();
+    if (std::less_equal<const char*>()(data(), src) &&
+        std::less_equal<const char*>()(src, data() + sz)) {
+        size_t offset = src - data();
+        raiseCapIfRequired(str.size());
+        src = data() + offset;
+    } else {
+        raiseCapIfRequired(str.size());
+    }
+    std::copy(src, src + str.size(), data() + sz);
+    sz += str.size();
+    data()[sz] = '\0';
     return *this;
 }
 
-size_t String::find(const String& substring) const {
-    for (size_t i = 0; i + substring.sz <= sz; ++i) {
-        if (checkSubstring(substring, i)) {
-            return i;
-        }
-    }
-    return sz;
+size_t String::find(StringView substring) const {
+    return StringView(*this).find(substring);
 }
 
-size_t String::rfind(const String& substring) const {
-    for (int i = sz - substring.sz; i >= 0; --i) {
-        if (checkSubstring(substring, static_cast<size_t>(i))) {
-            return static_cast<size_t>(i);
-        }
-    }
-    return sz;
+size_t String::rfind(StringView substring) const {
+    return StringView(*this).rfind(substring);
 }
 
 bool String::empty() const {
@@ -130,26 +270,31 @@ bool String::empty() const {
 
 void String::clear() {
     sz = 0;
-    arr[0] = '\0';
+    data()[0] = '\0';
+}
+
+void String::reserve(size_t new_cap) {
+    if (new_cap > cap) {
+        reallocate(new_cap);
+    }
 }
 
 void String::shrink_to_fit() {
-    if (cap == sz) {
+    if (cap == std::max(sz, kLocalCap)) {
         return;
     }
-    cap = sz;
-    char* new_arr = new char[cap + 1];
-    std::copy(arr, arr + sz + 1, new_arr);
-    std::swap(arr, new_arr);
-    delete[] new_arr;
+    char* old_arr = storage.arr;
+    allocate(sz);
+    std::copy(old_arr, old_arr + sz + 1, data());
+    delete[] old_arr;
 }
 
 const char* String::data() const {
-    return arr;
+    return cap == kLocalCap ? storage.local : storage.arr;
 }
 
 char* String::data() {
-    return arr;
+    return cap == kLocalCap ? storage.local : storage.arr;
 }
 
 size_t String::size() const {
@@ -161,41 +306,328 @@ size_t String::capacity() const {
 }
 
 String String::substr(size_t start, size_t count) const {
-    String res(count, '\0');
-    std::copy(arr + start, arr + start + count, res.arr);
+    return String(view(start, count));
+}
+
+StringView String::view(size_t start, size_t count) const {
+    return StringView(data() + start, count);
+}
+
+String String::join(const std::vector<String>& pieces,
+                    StringView separator) {
+    String res;
+    if (pieces.empty()) {
+        return res;
+    }
+    size_t total = separator.size() * (pieces.size() - 1);
+    for (const String& piece : pieces) {
+        total += piece.sz;
+    }
+    res.reserve(total);
+    res += pieces[0];
+    for (size_t i = 1; i < pieces.size(); ++i) {
+        res += separator;
+        res += pieces[i];
+    }
     return res;
 }
 
-bool operator==(const String& str1, const String& str2) {
+template <bool kReverse>
+unsigned char String::Searcher::at(const char* str, size_t len, size_t pos) {
+    return static_cast<unsigned char>(kReverse ? str[len - 1 - pos]
+                                               : str[pos]);
+}
+
+template <bool kReverse>
+size_t String::Searcher::maximalSuffix(StringView needle, bool greater,
+                                       size_t& period) {
+    const char* p = needle.data();
+    size_t m = needle.size();
+    size_t suffix = SIZE_MAX;
+    size_t j = 0;
+    size_t k = 1;
+    period = 1;
+    while (j + k < m) {
+        unsigned char a = at<kReverse>(p, m, j + k);
+        unsigned char b = at<kReverse>(p, m, suffix + k);
+        if (greater ? a > b : a < b) {
+            j += k;
+            k = 1;
+            period = j - suffix;
+        } else if (a == b) {
+            if (k != period) {
+                ++k;
+            } else {
+                j += period;
+                k = 1;
+            }
+        } else {
+            suffix = j++;
+            k = period = 1;
+        }
+    }
+    return suffix + 1;
+}
+
+template <bool kReverse>
+void String::Searcher::factorize(StringView needle,
+                                 Factorization& factorization) {
+    const char* p = needle.data();
+    size_t m = needle.size();
+    size_t period = 0;
+    size_t period_rev = 0;
+    size_t suffix = maximalSuffix<kReverse>(needle, false, period);
+    size_t suffix_rev = maximalSuffix<kReverse>(needle, true, period_rev);
+    if (suffix < suffix_rev) {
+        suffix = suffix_rev;
+        period = period_rev;
+    }
+    factorization.suffix = suffix;
+    factorization.periodic = true;
+    for (size_t i = 0; i < suffix; ++i) {
+        if (at<kReverse>(p, m, i) != at<kReverse>(p, m, i + period)) {
+            factorization.periodic = false;
+            break;
+        }
+    }
+    factorization.period = factorization.periodic
+                               ? period
+                               : std::max(suffix, m - suffix) + 1;
+    std::fill(factorization.shift, factorization.shift + 256, m);
+    for (size_t i = 0; i < m; ++i) {
+        factorization.shift[at<kReverse>(p, m, i)] = m - 1 - i;
+    }
+}
+
+template <bool kReverse>
+size_t String::Searcher::twoWay(const Factorization& factorization,
+                                StringView needle, StringView haystack) {
+    const char* p = needle.data();
+    size_t m = needle.size();
+    const char* text = haystack.data();
+    size_t n = haystack.size();
+    size_t suffix = factorization.suffix;
+    size_t period = factorization.period;
+    size_t memory = 0;
+    size_t j = 0;
+    while (j + m <= n) {
+        size_t shift = factorization.shift[at<kReverse>(text, n, j + m - 1)];
+        if (shift > 0) {
+            if (memory != 0 && shift < period) {
+                shift = m - period;
+            }
+            memory = 0;
+            j += shift;
+            continue;
+        }
+        size_t i = std::max(suffix, memory);
+        while (i < m - 1 &&
+               at<kReverse>(p, m, i) == at<kReverse>(text, n, i + j)) {
+            ++i;
+        }
+        if (i < m - 1) {
+            j += i - suffix + 1;
+            memory = 0;
+            continue;
+        }
+        i = suffix;
+        while (i > memory &&
+               at<kReverse>(p, m, i - 1) == at<kReverse>(text, n, i - 1 + j)) {
+            --i;
+        }
+        if (i <= memory) {
+            return kReverse ? n - m - j : j;
+        }
+        j += period;
+        memory = factorization.periodic ? m - period : 0;
+    }
+    return n;
+}
+
+template <bool kReverse>
+size_t String::Searcher::searchOnce(StringView needle, StringView text) {
+    Factorization factorization;
+    factorize<kReverse>(needle, factorization);
+    return twoWay<kReverse>(factorization, needle, text);
+}
+
+String::Searcher::Searcher(StringView needle)
+    : pattern(needle), forward(), backward() {
+    if (pattern.sz > kShortPattern) {
+        factorize<false>(pattern, forward);
+        factorize<true>(pattern, backward);
+    }
+}
+
+size_t String::Searcher::find(StringView text) const {
+    if (pattern.sz == 0) {
+        return 0;
+    }
+    if (pattern.sz <= kShortPattern || pattern.sz > text.size()) {
+        return findShort(text.data(), text.size(), pattern.data(), pattern.sz);
+    }
+    return twoWay<false>(forward, pattern, text);
+}
+
+size_t String::Searcher::rfind(StringView text) const {
+    if (pattern.sz == 0) {
+        return text.size();
+    }
+    if (pattern.sz <= kShortPattern || pattern.sz > text.size()) {
+        return rfindShort(text.data(), text.size(), pattern.data(),
+                          pattern.sz);
+    }
+    return twoWay<true>(backward, pattern, text);
+}
+
+StringView::StringView() : ptr(""), sz(0) {}
+
+StringView::StringView(const char* c_str) : ptr(c_str), sz(strlen(c_str)) {}
+
+StringView::StringView(const char* str, size_t count) : ptr(str), sz(count) {}
+
+StringView::StringView(const String& str) : ptr(str.data()), sz(str.size()) {}
+
+const char& StringView::operator[](size_t id) const {
+    return ptr[id];
+}
+
+size_t StringView::length() const {
+    return sz;
+}
+
+const char& StringView::front() const {
+    return ptr[0];
+}
+
+const char& StringView::back() const {
+    return ptr[sz - 1];
+}
+
+size_t StringView::find(StringView substring) const {
+    if (substring.sz == 0) {
+        return 0;
+    }
+    if (substring.sz <= String::kShortPattern || substring.sz > sz) {
+        return String::findShort(ptr, sz, substring.ptr, substring.sz);
+    }
+    return String::Searcher::searchOnce<false>(substring, *this);
+}
+
+size_t StringView::rfind(StringView substring) const {
+    if (substring.sz == 0) {
+        return sz;
+    }
+    if (substring.sz <= String::kShortPattern || substring.sz > sz) {
+        return String::rfindShort(ptr, sz, substring.ptr, substring.sz);
+    }
+    return String::Searcher::searchOnce<true>(substring, *this);
+}
+
+bool StringView::empty() const {
+    return sz == 0;
+}
+
+const char* StringView::data() const {
+    return ptr;
+}
+
+size_t StringView::size() const {
+    return sz;
+}
+
+StringView StringView::substr(size_t start, size_t count) const {
+    return StringView(ptr + start, count);
+}
+
+bool operator==(StringView str1, StringView str2) {
     if (str1.length() != str2.length()) {
         return false;
     }
-    return strcmp(str1.data(), str2.data()) == 0;
+    return memcmp(str1.data(), str2.data(), str1.length()) == 0;
 }
 
-bool operator!=(const String& str1, const String& str2) {
+bool operator!=(StringView str1, StringView str2) {
     return !(str1 == str2);
 }
 
-bool operator<(const String& str1, const String& str2) {
-    return strcmp(str1.data(), str2.data()) < 0;
+bool operator<(StringView str1, StringView str2) {
+    int cmp = memcmp(str1.data(), str2.data(),
+                     std::min(str1.length(), str2.length()));
+    return cmp < 0 || (cmp == 0 && str1.length() < str2.length());
 }
 
-bool operator>=(const String& str1, const String& str2) {
+bool operator>=(StringView str1, StringView str2) {
     return !(str1 < str2);
 }
 
-bool operator>(const String& str1, const String& str2) {
+bool operator>(StringView str1, StringView str2) {
     return str2 < str1;
 }
 
-bool operator<=(const String& str1, const String& str2) {
+bool operator<=(StringView str1, StringView str2) {
     return !(str2 < str1);
 }
 
-String operator+(String str1, const String& str2) {
+bool operator==(StringView str, char c) {
+    return str == StringView(&c, 1);
+}
+
+bool operator==(char c, StringView str) {
+    return StringView(&c, 1) == str;
+}
+
+bool operator!=(StringView str, char c) {
+    return str != StringView(&c, 1);
+}
+
+bool operator!=(char c, StringView str) {
+    return StringView(&c, 1) != str;
+}
+
+bool operator<(StringView str, char c) {
+    return str < StringView(&c, 1);
+}
+
+bool operator<(char c, StringView str) {
+    return StringView(&c, 1) < str;
+}
+
+bool operator>=(StringView str, char c) {
+    return str >= StringView(&c, 1);
+}
+
+bool operator>=(char c, StringView str) {
+    return StringView(&c, 1) >= str;
+}
+
+bool operator>(StringView str, char c) {
+    return str > StringView(&c, 1);
+}
+
+bool operator>(char c, StringView str) {
+    return StringView(&c, 1) > str;
+}
+
+bool operator<=(StringView str, char c) {
+    return str <= StringView(&c, 1);
+}
+
+bool operator<=(char c, StringView str) {
+    return StringView(&c, 1) <= str;
+}
+
+String operator+(const String& str1, const String& str2) {
+    String res;
+    res.reserve(str1.length() + str2.length());
+    res += str1;
+    res += str2;
+    return res;
+}
+
+String operator+(String&& str1, const String& str2) {
     str1 += str2;
-    return str1;
+    return std::move(str1);
 }
 
 std::istream& operator>>(std::istream& in, String& str) {
@@ -214,3 +646,115 @@ std::ostream& operator<<(std::ostream& out, const String& str) {
     }
     return out;
 }
+
+std::ostream& operator<<(std::ostream& out, StringView str) {
+    for (size_t i = 0; i < str.length(); ++i) {
+        out << str[i];
+    }
+    return out;
+}
+
+AhoCorasick::AhoCorasick(const std::vector<String>& patterns)
+    : byteClass(), classes(1), denseStates(0) {
+    for (const String& pattern : patterns) {
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            byteClass[static_cast<unsigned char>(pattern[i])] = 1;
+        }
+    }
+    for (size_t c = 0; c < 256; ++c) {
+        if (byteClass[c] != 0) {
+            byteClass[c] = static_cast<uint16_t>(classes++);
+        }
+    }
+
+    std::vector<std::vector<std::pair<uint16_t, uint32_t>>> children(1);
+    std::vector<std::vector<uint32_t>> terminals(1);
+    auto child = [&children](uint32_t node, uint16_t cls) {
+        for (const auto& [label, next] : children[node]) {
+            if (label == cls) {
+                return next;
+            }
+        }
+        return kNone;
+    };
+    for (size_t id = 0; id < patterns.size(); ++id) {
+        const String& pattern = patterns[id];
+        lengths.push_back(pattern.size());
+        if (pattern.empty()) {
+            continue;
+        }
+        uint32_t node = 0;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            uint16_t cls = byteClass[static_cast<unsigned char>(pattern[i])];
+            uint32_t next = child(node, cls);
+            if (next == kNone) {
+                next = static_cast<uint32_t>(children.size());
+                children[node].emplace_back(cls, next);
+                children.emplace_back();
+                terminals.emplace_back();
+            }
+            node = next;
+        }
+        terminals[node].push_back(static_cast<uint32_t>(id));
+    }
+
+    size_t count = children.size();
+    std::vector<uint32_t> order(1, 0);
+    std::vector<uint32_t> index(count);
+    std::vector<uint32_t> fail(count, 0);
+    for (size_t head = 0; head < order.size(); ++head) {
+        uint32_t node = order[head];
+        index[node] = static_cast<uint32_t>(head);
+        std::sort(children[node].begin(), children[node].end());
+        for (const auto& [cls, next] : children[node]) {
+            order.push_back(next);
+            if (node == 0) {
+                continue;
+            }
+            uint32_t f = fail[node];
+            while (f != 0 && child(f, cls) == kNone) {
+                f = fail[f];
+            }
+            uint32_t target = child(f, cls);
+            fail[next] = target == kNone ? 0 : target;
+        }
+    }
+
+    nodes.resize(count + 1);
+    for (size_t head = 0; head < count; ++head) {
+        uint32_t node = order[head];
+        Node& res = nodes[head];
+        res.fail = index[fail[node]];
+        res.edges = static_cast<uint32_t>(edgeTarget.size());
+        res.outputs = static_cast<uint32_t>(outputs.size());
+        for (const auto& [cls, next] : children[node]) {
+            edgeClass.push_back(cls);
+            edgeTarget.push_back(index[next]);
+        }
+        outputs.insert(outputs.end(), terminals[node].begin(),
+                       terminals[node].end());
+        res.report = !terminals[node].empty() ? static_cast<uint32_t>(head)
+                     : head == 0             ? kNone
+                                             : nodes[res.fail].report;
+    }
+    nodes[count].edges = static_cast<uint32_t>(edgeTarget.size());
+    nodes[count].outputs = static_cast<uint32_t>(outputs.size());
+
+    denseStates = std::min(count, std::max<size_t>(1, kDenseCells / classes));
+    dense.assign(denseStates * classes, 0);
+    for (size_t state = 0; state < denseStates; ++state) {
+        uint32_t* row = dense.data() + state * classes;
+        if (state != 0) {
+            const uint32_t* fallback =
+                dense.data() + nodes[state].fail * classes;
+            std::copy(fallback, fallback + classes, row);
+        }
+        for (uint32_t e = nodes[state].edges; e < nodes[state + 1].edges; ++e) {
+            row[edgeClass[e]] = edgeTarget[e];
+        }
+    }
+}
+
+size_t AhoCorasick::size() const {
+    return lengths.size();
+}
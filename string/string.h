@@ -1,20 +1,85 @@
+#if __cplusplus < 202002L
+#error "string.h requires C++20"
+#endif
+
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <vector>
+
+class String;
+
+class StringView {
+  private:
+    const char* ptr;
+    size_t sz;
+
+  public:
+    StringView();
+
+    StringView(const char* c_str);
+
+    StringView(const char* str, size_t count);
+
+    StringView(const String& str);
+
+    const char& operator[](size_t id) const;
+
+    size_t length() const;
+
+    const char& front() const;
+
+    const char& back() const;
+
+    size_t find(StringView substring) const;
+
+    size_t rfind(StringView substring) const;
+
+    bool empty() const;
+
+    const char* data() const;
+
+    size_t size() const;
+
+    StringView substr(size_t start, size_t count) const;
+};
 
 class String {
   private:
+    static constexpr size_t kLocalCap = 23;
+    static constexpr size_t kShortPattern = 32;
+
+    union Storage {
+        char* arr;
+        char local[kLocalCap + 1];
+    };
+
     size_t cap;
     size_t sz;
-    char* arr;
+    Storage storage;
+
+    void allocate(size_t n);
 
-    void Swap(String& str);
+    void release();
+
+    void Swap(String& str) noexcept;
+
+    void reallocate(size_t new_cap);
 
     void raiseCapIfRequired(size_t req_sz);
 
-    bool checkSubstring(const String& substring, size_t pos) const;
+    static size_t findShort(const char* text, size_t n, const char* pattern,
+                            size_t m);
+
+    static size_t rfindShort(const char* text, size_t n, const char* pattern,
+                             size_t m);
+
+    friend class StringView;
 
   public:
+    class Searcher;
+
     String();
 
     String(const char* c_str);
@@ -23,9 +88,15 @@ class String {
 
     String(char c);
 
+    explicit String(StringView str);
+
     String(const String& str);
 
-    String& operator=(String str);
+    String(String&& str) noexcept;
+
+    String& operator=(const String& str);
+
+    String& operator=(String&& str) noexcept;
 
     ~String();
 
@@ -49,16 +120,18 @@ class String {
 
     String& operator+=(char c);
 
-    String& operator+=(const String& str);
+    String& operator+=(StringView str);
 
-    size_t find(const String& substring) const;
+    size_t find(StringView substring) const;
 
-    size_t rfind(const String& substring) const;
+    size_t rfind(StringView substring) const;
 
     bool empty() const;
 
     void clear();
 
+    void reserve(size_t new_cap);
+
     void shrink_to_fit();
 
     const char* data() const;
@@ -70,22 +143,195 @@ class String {
     size_t capacity() const;
 
     String substr(size_t start, size_t count) const;
+
+    StringView view(size_t start, size_t count) const;
+
+    template <class... Pieces>
+    static String concat(const Pieces&... pieces);
+
+    static String join(const std::vector<String>& pieces,
+                       StringView separator = StringView());
 };
 
-bool operator==(const String& str1, const String& str2);
+class String::Searcher {
+  private:
+    struct Factorization {
+        size_t suffix;
+        size_t period;
+        bool periodic;
+        size_t shift[256];
+    };
+
+    String pattern;
+    Factorization forward;
+    Factorization backward;
+
+    template <bool kReverse>
+    static unsigned char at(const char* str, size_t len, size_t pos);
+
+    template <bool kReverse>
+    static size_t maximalSuffix(StringView needle, bool greater,
+                                size_t& period);
+
+    template <bool kReverse>
+    static void factorize(StringView needle, Factorization& factorization);
+
+    template <bool kReverse>
+    static size_t twoWay(const Factorization& factorization, StringView needle,
+                         StringView text);
+
+    template <bool kReverse>
+    static size_t searchOnce(StringView needle, StringView text);
+
+    friend class StringView;
+
+  public:
+    explicit Searcher(StringView needle);
+
+    size_t find(StringView text) const;
+
+    size_t rfind(StringView text) const;
+};
+
+template <class... Pieces>
+String String::concat(const Pieces&... pieces) {
+    String res;
+    res.reserve((size_t(0) + ... + StringView(pieces).length()));
+    ((res += pieces), ...);
+    return res;
+}
+
+bool operator==(StringView str1, StringView str2);
+
+bool operator!=(StringView str1, StringView str2);
+
+bool operator<(StringView str1, StringView str2);
+
+bool operator>=(StringView str1, StringView str2);
+
+bool operator>(StringView str1, StringView str2);
 
-bool operator!=(const String& str1, const String& str2);
+bool operator<=(StringView str1, StringView str2);
 
-bool operator<(const String& str1, const String& str2);
+bool operator==(StringView str, char c);
 
-bool operator>=(const String& str1, const String& str2);
+bool operator==(char c, StringView str);
 
-bool operator>(const String& str1, const String& str2);
+bool operator!=(StringView str, char c);
 
-bool operator<=(const String& str1, const String& str2);
+bool operator!=(char c, StringView str);
 
-String operator+(String str1, const String& str2);
+bool operator<(StringView str, char c);
+
+bool operator<(char c, StringView str);
+
+bool operator>=(StringView str, char c);
+
+bool operator>=(char c, StringView str);
+
+bool operator>(StringView str, char c);
+
+bool operator>(char c, StringView str);
+
+bool operator<=(StringView str, char c);
+
+bool operator<=(char c, StringView str);
+
+String operator+(const String& str1, const String& str2);
+
+String operator+(String&& str1, const String& str2);
 
 std::istream& operator>>(std::istream& in, String& str);
 
 std::ostream& operator<<(std::ostream& out, const String& str);
+
+std::ostream& operator<<(std::ostream& out, StringView str);
+
+class AhoCorasick {
+  private:
+    static constexpr uint32_t kNone = UINT32_MAX;
+    static constexpr size_t kDenseCells = 1 << 16;
+    static constexpr size_t kChunk = 1 << 16;
+
+    struct Node {
+        uint32_t fail;
+        uint32_t edges;
+        uint32_t outputs;
+        uint32_t report;
+    };
+
+    uint16_t byteClass[256];
+    size_t classes;
+    size_t denseStates;
+    std::vector<Node> nodes;
+    std::vector<uint16_t> edgeClass;
+    std::vector<uint32_t> edgeTarget;
+    std::vector<uint32_t> dense;
+    std::vector<uint32_t> outputs;
+    std::vector<size_t> lengths;
+
+    uint32_t step(uint32_t state, unsigned char c) const {
+        size_t cls = byteClass[c];
+        if (cls == 0) {
+            return 0;
+        }
+        while (state >= denseStates) {
+            for (uint32_t e = nodes[state].edges; e < nodes[state + 1].edges;
+                 ++e) {
+                if (edgeClass[e] == cls) {
+                    return edgeTarget[e];
+                }
+            }
+            state = nodes[state].fail;
+        }
+        return dense[state * classes + cls];
+    }
+
+    template <class Callback>
+    void scan(const char* text, size_t n, size_t offset, uint32_t& state,
+              Callback& callback) const;
+
+  public:
+    explicit AhoCorasick(const std::vector<String>& patterns);
+
+    size_t size() const;
+
+    template <class Callback>
+    void scan(StringView text, Callback callback) const;
+
+    template <class Callback>
+    void scan(std::istream& in, Callback callback) const;
+};
+
+template <class Callback>
+void AhoCorasick::scan(const char* text, size_t n, size_t offset,
+                       uint32_t& state, Callback& callback) const {
+    for (size_t i = 0; i < n; ++i) {
+        state = step(state, static_cast<unsigned char>(text[i]));
+        for (uint32_t r = nodes[state].report; r != kNone;
+             r = nodes[nodes[r].fail].report) {
+            for (uint32_t k = nodes[r].outputs; k < nodes[r + 1].outputs; ++k) {
+                callback(size_t(outputs[k]),
+                         offset + i + 1 - lengths[outputs[k]]);
+            }
+        }
+    }
+}
+
+template <class Callback>
+void AhoCorasick::scan(StringView text, Callback callback) const {
+    uint32_t state = 0;
+    scan(text.data(), text.size(), 0, state, callback);
+}
+
+template <class Callback>
+void AhoCorasick::scan(std::istream& in, Callback callback) const {
+    std::vector<char> buffer(kChunk);
+    uint32_t state = 0;
+    size_t offset = 0;
+    while (in.read(buffer.data(), kChunk) || in.gcount() > 0) {
+        size_t got = in.gcount();
+        scan(buffer.data(), got, offset, state, callback);
+        offset += got;
+    }
+}
@@ -0,0 +1,585 @@
+#include "../biginteger/biginteger.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+template <class Func>
+bool throwsDomainError(Func func) {
+    try {
+        func();
+    } catch (const std::domain_error&) {
+        return true;
+    }
+    return false;
+}
+
+BigInteger randomBits(std::mt19937& rng, size_t limbs) {
+    if (limbs == 1) {
+        uint32_t limb = rng();
+        return BigInteger(static_cast<int>(limb >> 1)) << 1 | (limb & 1);
+    }
+    size_t low = limbs / 2;
+    return randomBits(rng, limbs - low) << 32 * low | randomBits(rng, low);
+}
+
+BigInteger randomLimbs(std::mt19937& rng, size_t limbs) {
+    return randomBits(rng, limbs) | BigInteger(1) << (32 * limbs - 1);
+}
+
+// Multiplies by slices of bnum2 short enough for the schoolbook kernel.
+BigInteger schoolbookProduct(const BigInteger& bnum1,
+                             const BigInteger& bnum2) {
+    const size_t kSliceBits = 32 * 32;
+    BigInteger mask = (BigInteger(1) << kSliceBits) - 1;
+    size_t slices = (bnum2.limbCount() + 31) / 32;
+    BigInteger res;
+    for (size_t i = slices; i-- > 0;) {
+        res <<= kSliceBits;
+        res += bnum1 * ((bnum2 >> i * kSliceBits) & mask);
+    }
+    return res;
+}
+
+void testMultiplicationCutoffs() {
+    std::mt19937 rng(2);
+    for (size_t cutoff : {40, 1500, 16000}) {
+        for (size_t len : {cutoff - 1, cutoff, cutoff + 1}) {
+            BigInteger num1 = randomLimbs(rng, len);
+            BigInteger num2 = randomLimbs(rng, len + 3);
+            assert(num1.limbCount() == len);
+            assert(num1 * num2 == schoolbookProduct(num1, num2));
+            assert(num1 * num1 == schoolbookProduct(num1, num1));
+            assert(-num1 * num2 == -schoolbookProduct(num2, num1));
+        }
+    }
+}
+
+void testDivisionCutoffs() {
+    std::mt19937 rng(3);
+    for (size_t len : {999, 1000, 1001, 2100}) {
+        for (size_t extra : {999, 1000, 1001}) {
+            BigInteger divisor = randomLimbs(rng, len);
+            BigInteger quotient = randomLimbs(rng, extra);
+            BigInteger rem = randomLimbs(rng, len) >> 1;
+            BigInteger dividend = quotient * divisor + rem;
+            assert(dividend / divisor == quotient);
+            assert(dividend % divisor == rem);
+            assert(-dividend / divisor == -quotient);
+            auto [quot, res] = divmod(dividend - rem + divisor, divisor);
+            assert(quot == quotient + 1 && res == 0);
+        }
+    }
+}
+
+std::string randomDecimal(std::mt19937& rng, size_t digits) {
+    std::string res(digits, '0');
+    res[0] = static_cast<char>('1' + rng() % 9);
+    for (size_t i = 1; i < digits; ++i) {
+        res[i] = static_cast<char>('0' + rng() % 10);
+    }
+    return res;
+}
+
+// Horner's rule over single digits, independent of the conversion code.
+BigInteger slowDecimal(const std::string& str) {
+    BigInteger res;
+    for (char c : str) {
+        if (c != '-') {
+            res = res * 10 + (c - '0');
+        }
+    }
+    return str.front() == '-' ? -res : res;
+}
+
+void checkDecimalRoundTrip(const std::string& str) {
+    BigInteger num(str);
+    assert(num == slowDecimal(str));
+    assert(num.toString() == str);
+    assert(BigInteger::fromChars(str) == num);
+    std::string buf(num.maxCharsLength(), '\0');
+    char* end = num.toChars(buf.data());
+    assert(std::string(buf.data(), end) == str);
+}
+
+void testDecimalConversion() {
+    std::mt19937 rng(4);
+    for (size_t digits : {1, 9, 10, 19, 1349, 1350, 1351, 1446, 5000, 20000}) {
+        std::string str = randomDecimal(rng, digits);
+        checkDecimalRoundTrip(str);
+        checkDecimalRoundTrip("-" + str);
+    }
+    for (size_t zeros : {9, 1350, 4000}) {
+        checkDecimalRoundTrip("1" + std::string(zeros, '0'));
+        checkDecimalRoundTrip("-1" + std::string(zeros, '0') + "1");
+        checkDecimalRoundTrip(std::string(zeros, '9'));
+    }
+    checkDecimalRoundTrip("0");
+    assert(BigInteger::fromChars("+1234") == 1234);
+    assert(BigInteger::fromChars("000123") == 123);
+    for (const char* zero : {"-0", "+0", "-000"}) {
+        BigInteger num = BigInteger::fromChars(zero);
+        assert(num == 0 && num.numSign() == 1);
+        assert(num.toString() == "0");
+        assert(num.serializedSize() == BigInteger().serializedSize());
+    }
+}
+
+void testSerialization() {
+    std::mt19937 rng(5);
+    std::vector<BigInteger> values = {0,
+                                      1,
+                                      -1,
+                                      BigInteger(1) << 32,
+                                      -(BigInteger(1) << 64) + 1,
+                                      randomLimbs(rng, 200),
+                                      -randomLimbs(rng, 10000)};
+    Rational ratio = Rational(randomLimbs(rng, 30)) / Rational(-7);
+    std::ostringstream out;
+    BigIntegerWriter writer(out);
+    size_t expected_size = ratio.serializedSize();
+    for (const BigInteger& value : values) {
+        writer << value;
+        expected_size += value.serializedSize();
+
+        std::vector<std::byte> buf(value.serializedSize());
+        assert(value.serialize(buf) == buf.size());
+        BigInteger decoded(7);
+        assert(decoded.deserialize(buf) == buf.size());
+        assert(decoded == value);
+    }
+    writer << ratio;
+    std::string bytes = out.str();
+    assert(bytes.size() == expected_size);
+
+    std::vector<std::byte> data(bytes.size());
+    std::memcpy(data.data(), bytes.data(), bytes.size());
+    BigIntegerReader reader(data);
+    for (const BigInteger& value : values) {
+        BigInteger decoded;
+        reader >> decoded;
+        assert(decoded == value);
+    }
+    Rational decoded_ratio;
+    reader >> decoded_ratio;
+    assert(decoded_ratio == ratio);
+    assert(reader.atEnd() && reader.position() == data.size());
+}
+
+void checkExtendedGcd(const BigInteger& bnum1, const BigInteger& bnum2) {
+    BigInteger coef1, coef2;
+    BigInteger div = extendedGcd(bnum1, bnum2, coef1, coef2);
+    assert(div == gcd(bnum1, bnum2));
+    assert(div >= 0);
+    assert(bnum1 * coef1 + bnum2 * coef2 == div);
+    if (div != 0) {
+        assert(bnum1 % div == 0 && bnum2 % div == 0);
+        assert(gcd(bnum1 / div, bnum2 / div) == 1);
+    }
+    BigInteger mult = lcm(bnum1, bnum2);
+    assert(mult >= 0);
+    BigInteger product = bnum1 * bnum2;
+    assert(mult * div == (product < 0 ? -product : product));
+}
+
+void testGcd() {
+    assert(gcd(12, 18) == 6);
+    assert(gcd(-12, 18) == 6);
+    assert(gcd(0, -5) == 5);
+    assert(gcd(0, 0) == 0);
+    assert(lcm(4, 6) == 12);
+    assert(lcm(-4, 6) == 12);
+    assert(lcm(0, 5) == 0);
+
+    BigInteger fib1 = 0, fib2 = 1;
+    for (int i = 0; i < 3000; ++i) {
+        fib1 += fib2;
+        std::swap(fib1, fib2);
+    }
+    assert(gcd(fib2, fib1) == 1);
+    checkExtendedGcd(fib2, fib1);
+
+    std::mt19937 rng(6);
+    BigInteger common = randomLimbs(rng, 300);
+    BigInteger factor = randomLimbs(rng, 200);
+    assert(gcd(common * factor, common * (factor + 1)) == common);
+    const BigInteger values[] = {0,
+                                 1,
+                                 -7,
+                                 BigInteger(1) << 64,
+                                 common * factor,
+                                 -common * (factor + 1),
+                                 randomLimbs(rng, 3),
+                                 randomLimbs(rng, 150)};
+    for (const BigInteger& value1 : values) {
+        for (const BigInteger& value2 : values) {
+            checkExtendedGcd(value1, value2);
+        }
+    }
+}
+
+void checkRoot(const BigInteger& bnum, unsigned degree) {
+    BigInteger root = iroot(bnum, degree);
+    assert(pow(root, degree) <= bnum);
+    assert(bnum < pow(root + 1, degree));
+}
+
+void testRoots() {
+    assert(isqrt(0) == 0);
+    assert(isqrt(1) == 1);
+    assert(isqrt(15) == 3);
+    assert(isqrt(16) == 4);
+    assert(isqrt(pow(BigInteger(10), 100)) == pow(BigInteger(10), 50));
+    assert(iroot(-27, 3) == -3);
+    assert(iroot(-30, 3) == -3);
+    assert(iroot(12345, 1) == 12345);
+    assert(throwsDomainError([] { return iroot(-4, 2); }));
+    assert(throwsDomainError([] { return iroot(4, 0); }));
+
+    std::mt19937 rng(7);
+    for (size_t limbs : {1, 2, 3, 50, 500}) {
+        BigInteger num = randomLimbs(rng, limbs);
+        for (unsigned degree : {2, 3, 5, 7, 31}) {
+            checkRoot(num, degree);
+            BigInteger base = randomLimbs(rng, (limbs + degree - 1) / degree);
+            BigInteger power = pow(base, degree);
+            assert(iroot(power, degree) == base);
+            assert(iroot(power - 1, degree) == base - 1);
+            checkRoot(power + 1, degree);
+        }
+    }
+}
+
+void testBitwise() {
+    assert((BigInteger(-6) & 3) == 2);
+    assert((BigInteger(-6) | 3) == -5);
+    assert((BigInteger(-6) ^ 3) == -7);
+    assert((BigInteger(-6) & -3) == -8);
+    assert(~BigInteger(0) == -1);
+    BigInteger word = BigInteger(1) << 64;
+    assert((-word & (word + 5)) == word);
+    assert((-word | (word - 1)) == -1);
+    assert((BigInteger(-5) >> 1) == -3);
+    assert((BigInteger(5) >> 1) == 2);
+    assert((BigInteger(-1) >> 100) == -1);
+
+    std::mt19937 rng(8);
+    BigInteger big1 = randomLimbs(rng, 40), big2 = randomLimbs(rng, 25);
+    const BigInteger values[] = {0, 1, -1, 255, -256, word, -word,
+                                 big1, -big1, big2, -big2};
+    for (const BigInteger& value1 : values) {
+        assert(~value1 == -value1 - 1);
+        assert(~~value1 == value1);
+        assert((value1 & ~value1) == 0);
+        assert((value1 | ~value1) == -1);
+        assert((value1 ^ value1) == 0);
+        for (size_t shift : {1, 31, 32, 33, 100}) {
+            BigInteger shifted = value1 >> shift;
+            assert((value1 << shift) == value1 * pow(BigInteger(2), shift));
+            assert((shifted << shift) <= value1);
+            assert(value1 < (shifted + 1) << shift);
+        }
+        for (const BigInteger& value2 : values) {
+            BigInteger both = value1 & value2, any = value1 | value2;
+            assert(both + any == value1 + value2);
+            assert((value1 ^ value2) == any - both);
+            assert(((value1 ^ value2) ^ value2) == value1);
+            assert(~(value1 & value2) == (~value1 | ~value2));
+        }
+    }
+
+    assert(BigInteger(0).popcount() == 0);
+    assert(BigInteger(-7).popcount() == 3);
+    assert(((BigInteger(1) << 100) - 1).popcount() == 100);
+    assert((big1 | big2).popcount() + (big1 & big2).popcount() ==
+           big1.popcount() + big2.popcount());
+}
+
+void testFactorialAndBinomial() {
+    assert(factorial(0) == 1);
+    assert(factorial(1) == 1);
+    assert(factorial(20) == BigInteger("2432902008176640000"));
+    BigInteger product = 1;
+    for (uint64_t num = 1; num <= 3000; ++num) {
+        product *= static_cast<int>(num);
+        if (num % 97 == 0 || num == 3000) {
+            assert(factorial(num) == product);
+        }
+    }
+    assert(factorial(3000, 4) == product);
+
+    std::vector<BigInteger> row = {1};
+    for (uint64_t num = 1; num <= 80; ++num) {
+        std::vector<BigInteger> next(num + 1, 1);
+        for (uint64_t choose = 1; choose < num; ++choose) {
+            next[choose] = row[choose - 1] + row[choose];
+        }
+        row = std::move(next);
+        for (uint64_t choose = 0; choose <= num; ++choose) {
+            assert(binomial(num, choose) == row[choose]);
+        }
+        assert(binomial(num, num + 1) == 0);
+    }
+    assert(binomial(2000, 1000) ==
+           factorial(2000) / (factorial(1000) * factorial(1000)));
+    assert(binomial(2000, 1000, 3) == binomial(2000, 1000));
+    BigInteger big = 1'000'000;
+    assert(binomial(1'000'000, 4) ==
+           big * (big - 1) * (big - 2) * (big - 3) / 24);
+}
+
+template <class Func>
+bool throwsOverflowError(Func func) {
+    try {
+        func();
+    } catch (const std::overflow_error&) {
+        return true;
+    }
+    return false;
+}
+
+static_assert(std::is_trivially_copyable_v<Int256>);
+static_assert(Int128(-1) + 1 == 0);
+static_assert((Int128(1) << 127) < 0);
+static_assert((Int128(1) << 127) - 1 > 0);
+static_assert(Int512(Int128(-3)) == -3);
+static_assert(FixedBigInteger<128>::fromLiteral(
+                  "0xFFFF'FFFF'FFFF'FFFF'FFFF'FFFF'FFFF'FFFF") ==
+              FixedBigInteger<128>::fromChars(
+                  "340282366920938463463374607431768211455"));
+static_assert(FixedBigInteger<64>(1'000'000'007) * 1'000'000'007 %
+                  998'244'353 ==
+              740'650'005);
+static_assert(-FixedBigInteger<64>(7) / 2 == -3);
+static_assert(-FixedBigInteger<64>(7) % 2 == -1);
+
+// Reduces bnum to the signed value a WideInt<kBits> wraps it to.
+BigInteger wrapToBits(const BigInteger& bnum, size_t bits) {
+    BigInteger modulus = BigInteger(1) << bits;
+    BigInteger res = bnum & (modulus - 1);
+    return res >= modulus / 2 ? res - modulus : res;
+}
+
+void testWideInt() {
+    const Int128 kMin = Int128(1) << 127;
+    const Int128 kMax = kMin - 1;
+    assert(kMax + 1 == kMin);
+    assert(kMin - 1 == kMax);
+    assert(-kMin == kMin);
+    assert(kMax * 2 == -2);
+    assert((Int128(1) << 64) * (Int128(1) << 64) == 0);
+    assert(Int256(-7) / 2 == -3 && Int256(-7) % 2 == -1);
+    assert(BigInteger(Int256(7) % -2) == BigInteger(7) % -2);
+    assert(Int256(7) / -2 == -3 && Int256(7) % -2 == -1);
+    assert((Int128(-1) >> 100) == -1);
+    assert(Int128(-12345).toString() == "-12345");
+    assert(Int1024(-1).popcount() == 1);
+
+    BigInteger big_min = -(BigInteger(1) << 127);
+    assert(BigInteger(kMin) == big_min);
+    assert(Int128(big_min) == kMin);
+    assert(Int128(-big_min - 1) == kMax);
+    assert(throwsOverflowError([&] { return Int128(-big_min); }));
+    assert(throwsOverflowError([&] { return Int128(big_min - 1); }));
+
+    std::mt19937 rng(9);
+    for (int i = 0; i < 200; ++i) {
+        BigInteger num1 = wrapToBits(randomLimbs(rng, 1 + rng() % 8), 256);
+        BigInteger num2 = wrapToBits(randomLimbs(rng, 1 + rng() % 8), 256);
+        if (rng() % 2 == 0) {
+            num2 = -num2;
+        }
+        Int256 wide1(num1), wide2(num2);
+        assert(BigInteger(wide1 + wide2) == wrapToBits(num1 + num2, 256));
+        assert(BigInteger(wide1 - wide2) == wrapToBits(num1 - num2, 256));
+        assert(BigInteger(wide1 * wide2) == wrapToBits(num1 * num2, 256));
+        assert(BigInteger(wide1 & wide2) == (num1 & num2));
+        assert(BigInteger(wide1 ^ wide2) == (num1 ^ num2));
+        assert((wide1 < wide2) == (num1 < num2));
+        if (num2 != 0 && !(num1 == -(BigInteger(1) << 255) && num2 == -1)) {
+            assert(BigInteger(wide1 / wide2) == num1 / num2);
+            assert(BigInteger(wide1 % wide2) == num1 % num2);
+        }
+    }
+}
+
+void testFixedBigInteger() {
+    using Fixed64 = FixedBigInteger<64>;
+    const Fixed64 kMax = Fixed64::fromChars("18446744073709551615");
+    assert(kMax.limbCount() == 2);
+    assert(BigInteger(kMax) == (BigInteger(1) << 64) - 1);
+    assert(-kMax - (-kMax) == 0);
+    assert(throwsOverflowError([&] { return kMax + 1; }));
+    assert(throwsOverflowError([&] { return -kMax - 1; }));
+    assert(throwsOverflowError([&] { return kMax * 2; }));
+    assert(throwsOverflowError(
+        [] { return Fixed64::fromChars("18446744073709551616"); }));
+    using Fixed70 = FixedBigInteger<70>;
+    assert(throwsOverflowError(
+        [] { return Fixed70::fromChars("1180591620717411303424"); }));
+    assert(BigInteger(Fixed70::fromChars("1180591620717411303423")) ==
+           (BigInteger(1) << 70) - 1);
+    assert(throwsOverflowError([] { return Fixed64(BigInteger(1) << 64); }));
+    assert(Fixed64(-(BigInteger(1) << 63)) == -Fixed64(1LL << 62) * 2);
+
+    BigInteger wide("-1234567890123456789012345678901234567890"
+                    "12345678901234567890");
+    assert(BigInteger(FixedBigInteger<256>(wide)) == wide);
+    assert(0x1'0000'0000_bi == BigInteger(1) << 32);
+    assert(0b1010_bi == 10 && 017_bi == 15 && 1'000_bi == 1000);
+    assert("123456789012345678901234567890123456789012345678901234567890"
+           "123456789012345678901234567890"_bi ==
+           BigInteger("123456789012345678901234567890123456789012345678901234"
+                      "567890123456789012345678901234567890"));
+}
+
+void testDivisionByZero() {
+    BigInteger num("123456789012345678901234567890");
+    BigInteger zero;
+    assert(throwsDomainError([&] { return num / zero; }));
+    assert(throwsDomainError([&] { return num % zero; }));
+    assert(throwsDomainError([&] { return num / 0u; }));
+    assert(throwsDomainError([&] { return num % 0u; }));
+    assert(throwsDomainError([&] { return divmod(num, zero); }));
+    assert(throwsDomainError([&] { return divmod(num, 0); }));
+    assert(throwsDomainError([] { return Rational(0) / Rational(0); }));
+    assert(throwsDomainError([] { return Rational(1) / Rational(0); }));
+    assert(num / 7 == BigInteger("17636684144620811271604938270"));
+}
+
+void testSiftLeft() {
+    BigInteger num(5);
+    num.siftLeft();
+    assert(num == BigInteger("5000000000"));
+    BigInteger neg("-123456789012345678901");
+    neg.siftLeft();
+    assert(neg == BigInteger("-123456789012345678901000000000"));
+    BigInteger zero;
+    zero.siftLeft();
+    assert(zero == 0);
+}
+
+void testLimbAccess() {
+    BigInteger num("-18446744073709551621");
+    assert(num.limbCount() == 3);
+    assert(num.limb(0) == 5 && num.limb(1) == 0 && num.limb(2) == 1);
+    assert(BigInteger().limbCount() == 0);
+    assert(BigInteger(-1).limbCount() == 1);
+}
+
+void testMontgomeryModulus() {
+    assert(throwsDomainError([] { return MontgomeryContext(10); }));
+    assert(throwsDomainError([] { return MontgomeryContext(0); }));
+    assert(throwsDomainError([] { return MontgomeryContext(-4); }));
+    assert(MontgomeryContext(11).pow(3, 2) == 9);
+    assert(MontgomeryContext(-11).pow(2, 10) == 1);
+    assert(powmod(3, 2, 10) == 9);
+}
+
+template <class Func>
+bool throwsInvalidArgument(Func func) {
+    try {
+        func();
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+void testRationalDeserialize() {
+    Rational value(7);
+    value /= Rational(-12);
+    std::vector<std::byte> buf(value.serializedSize());
+    value.serialize(buf);
+    Rational decoded;
+    assert(decoded.deserialize(buf) == buf.size());
+    assert(decoded == value);
+
+    auto encode = [](const BigInteger& num, const BigInteger& den) {
+        std::vector<std::byte> res(num.serializedSize() +
+                                   den.serializedSize());
+        size_t size = num.serialize(res);
+        den.serialize(std::span<std::byte>(res).subspan(size));
+        return res;
+    };
+    Rational kept(5);
+    for (const auto& bad : {encode(2, 4), encode(1, -3), encode(1, 0),
+                            encode(0, 2)}) {
+        assert(throwsInvalidArgument([&] { return kept.deserialize(bad); }));
+        assert(kept == Rational(5));
+    }
+}
+
+void testAccumulatorDivisionByZero() {
+    RationalAccumulator acc(Rational(3));
+    assert(throwsDomainError([&] { acc /= Rational(0); }));
+    assert(acc == Rational(3));
+    RationalAccumulator empty;
+    assert(throwsDomainError([&] { empty /= Rational(0); }));
+    acc /= Rational(-6);
+    assert(acc.normalize() == Rational(1) / Rational(-2));
+}
+
+void testAccumulatorComparisons() {
+    RationalAccumulator sum;
+    RationalAccumulator product(Rational(1));
+    for (int i = 1; i <= 40; ++i) {
+        sum += Rational(1) / Rational(i * (i + 1));
+        product *= Rational(i) / Rational(i + 1);
+    }
+    Rational sum_value = Rational(40) / Rational(41);
+    Rational product_value = Rational(1) / Rational(41);
+    assert(sum == sum_value);
+    assert(sum_value == sum);
+    assert(sum != product);
+    assert(product == product_value);
+    assert(product < sum);
+    assert(sum > product);
+    assert(product <= sum && sum >= product);
+    assert(sum <= sum_value && sum >= sum_value);
+    assert(!(sum < sum_value) && !(sum > sum_value));
+    assert(sum < Rational(1) && Rational(0) < sum);
+    assert(sum != Rational(1));
+
+    RationalAccumulator neg = sum;
+    neg -= Rational(2);
+    assert(neg < 0 && neg < product && product > neg);
+    assert(neg == Rational(-42) / Rational(41));
+    neg /= Rational(-1);
+    assert(neg > sum);
+    assert(neg == RationalAccumulator(Rational(42) / Rational(41)));
+    RationalAccumulator zero = sum;
+    zero -= sum_value;
+    assert(zero == 0 && zero == RationalAccumulator());
+    assert(!(zero < 0) && !(zero > 0));
+}
+
+}  // namespace
+
+int main() {
+    testDivisionByZero();
+    testSiftLeft();
+    testLimbAccess();
+    testMontgomeryModulus();
+    testRationalDeserialize();
+    testAccumulatorDivisionByZero();
+    testAccumulatorComparisons();
+    testMultiplicationCutoffs();
+    testDivisionCutoffs();
+    testDecimalConversion();
+    testSerialization();
+    testGcd();
+    testRoots();
+    testBitwise();
+    testFactorialAndBinomial();
+    testWideInt();
+    testFixedBigInteger();
+}
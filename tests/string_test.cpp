@@ -0,0 +1,188 @@
+#include "../string/string.h"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+void testMoveAssignment() {
+    String target(40, 't');
+    String source(50, 's');
+    const char* buffer = source.data();
+    target = std::move(source);
+    assert(target == String(50, 's'));
+    assert(target.data() == buffer);
+    assert(source.empty());
+    assert(source.size() == 0);
+    assert(source.data()[0] == '\0');
+    source += "reused";
+    assert(source == String("reused"));
+
+    String small("abc");
+    String other("xyz");
+    small = std::move(other);
+    assert(small == String("xyz"));
+    assert(other.empty());
+
+    String& alias = small;
+    small = std::move(alias);
+    assert(small == String("xyz"));
+}
+
+void testLongPatternSearch() {
+    String needle = String(40, 'a') + "b";
+    String text = String(100, 'a') + "b" + String(50, 'a') + "b";
+    assert(text.find(needle) == 60);
+    assert(text.rfind(needle) == 111);
+    assert(text.view(0, 120).rfind(needle) == 60);
+    assert(text.find(String(41, 'b')) == text.size());
+    String::Searcher searcher(needle);
+    assert(searcher.find(text) == 60);
+    assert(searcher.rfind(text) == 111);
+}
+
+void testAhoCorasickAllBytes() {
+    std::vector<String> patterns;
+    String text;
+    for (int c = 0; c < 256; ++c) {
+        patterns.push_back(String(1, static_cast<char>(c)));
+        text.push_back(static_cast<char>(c));
+    }
+    AhoCorasick automaton(patterns);
+    std::vector<size_t> hits(256, 0);
+    size_t total = 0;
+    automaton.scan(text, [&](size_t id, size_t pos) {
+        assert(id == pos);
+        ++hits[id];
+        ++total;
+    });
+    assert(total == 256);
+    assert(std::count(hits.begin(), hits.end(), 1) == 256);
+}
+
+void testCharComparisons() {
+    String single('a');
+    assert(single == 'a');
+    assert('a' == single);
+    assert(single != 'b');
+    assert('b' != single);
+    assert(single < 'b');
+    assert('0' < single);
+    assert(String("ab") > 'a');
+    assert('b' > String("ab"));
+    assert(single <= 'a');
+    assert('a' >= single);
+    assert(StringView("a") == 'a');
+    assert(String() < 'a');
+}
+
+bool isInline(const String& str) {
+    const char* begin = reinterpret_cast<const char*>(&str);
+    return str.data() >= begin && str.data() < begin + sizeof(String);
+}
+
+void testSsoBoundary() {
+    for (size_t len : {22, 23, 24}) {
+        String str(len, 'x');
+        assert(str.size() == len && str.data()[len] == '\0');
+        assert(isInline(str) == (len <= 23));
+        String copy = str;
+        assert(copy == str && isInline(copy) == (len <= 23));
+    }
+
+    String grown(22, 'a');
+    grown.push_back('b');
+    assert(isInline(grown) && grown.capacity() == 23);
+    grown.push_back('c');
+    assert(!isInline(grown) && grown.capacity() >= 24);
+    assert(grown == String(22, 'a') + "bc");
+    assert(grown.data()[24] == '\0');
+
+    grown.pop_back();
+    grown.shrink_to_fit();
+    assert(isInline(grown) && grown.capacity() == 23);
+    assert(grown == String(22, 'a') + "b");
+    grown += "cd";
+    assert(grown == String(22, 'a') + "bcd");
+
+    String heap(100, 'z');
+    heap.clear();
+    heap += "short";
+    heap.shrink_to_fit();
+    assert(isInline(heap) && heap == String("short"));
+    String sized(40, 'q');
+    sized.reserve(200);
+    sized.shrink_to_fit();
+    assert(sized.capacity() == 40 && sized == String(40, 'q'));
+    String local(5, 'l');
+    local.shrink_to_fit();
+    assert(isInline(local) && local == String(5, 'l'));
+}
+
+void testConcatAndJoin() {
+    String tail(30, 'x');
+    String joined = String::concat(String("ab"), "cd", StringView("ef"), tail);
+    assert(joined == String("abcdef") + tail);
+    assert(joined.capacity() == joined.size());
+    assert(String::concat() == String());
+    assert(String::concat("short", "er") == String("shorter"));
+
+    std::vector<String> pieces = {"a", "b", "c"};
+    assert(String::join({}, ", ") == String());
+    assert(String::join({"alone"}, ", ") == String("alone"));
+    assert(String::join(pieces, ", ") == String("a, b, c"));
+    assert(String::join(pieces) == String("abc"));
+    pieces.push_back(String(20, 'd'));
+    String long_join = String::join(pieces, "--");
+    assert(long_join == String("a--b--c--") + String(20, 'd'));
+    assert(long_join.capacity() == long_join.size());
+}
+
+void testAhoCorasickStream() {
+    // Matches the automaton's read size, so the needles below straddle the
+    // boundaries between chunks.
+    const size_t kChunk = 1 << 16;
+    std::vector<String> patterns = {"needle", "dle", "n", "xyzzy"};
+    AhoCorasick automaton(patterns);
+    std::string text(3 * kChunk + 100, '.');
+    text.replace(kChunk - 3, 6, "needle");
+    text.replace(2 * kChunk - 2, 5, "xyzzy");
+    text.replace(3 * kChunk - 6, 6, "needle");
+    text.replace(3 * kChunk + 10, 6, "needle");
+
+    using Match = std::pair<size_t, size_t>;
+    std::vector<Match> expected, streamed;
+    automaton.scan(StringView(text.data(), text.size()),
+                   [&](size_t id, size_t pos) {
+                       expected.push_back({id, pos});
+                   });
+    std::istringstream in(text);
+    automaton.scan(in, [&](size_t id, size_t pos) {
+        streamed.push_back({id, pos});
+    });
+    assert(streamed == expected);
+    assert(expected.size() == 3 * 3 + 1);
+    for (size_t pos : {kChunk - 3, 3 * kChunk - 6, 3 * kChunk + 10}) {
+        assert(std::count(expected.begin(), expected.end(), Match(0, pos)));
+        assert(std::count(expected.begin(), expected.end(), Match(1, pos + 3)));
+        assert(std::count(expected.begin(), expected.end(), Match(2, pos)));
+    }
+    assert(std::count(expected.begin(), expected.end(),
+                      Match(3, 2 * kChunk - 2)));
+}
+
+}  // namespace
+
+int main() {
+    testMoveAssignment();
+    testLongPatternSearch();
+    testAhoCorasickAllBytes();
+    testCharComparisons();
+    testSsoBoundary();
+    testConcatAndJoin();
+    testAhoCorasickStream();
+}